@@ -6,7 +6,7 @@
  *   使用 KMP 算法进行数据匹配，计算角度偏移量
  *
  * 数据流程:
- *   1. 从 redar_to_algorithm 队列接收 360 个角度的雷达数据
+ *   1. 订阅 radar/scan 主题, 得到 360 个角度雷达数据的引用, 不复制
  *   2. 使用 KMP 算法进行模式匹配
  *   3. 计算匹配位置，得到角度偏移量 delta_theta
  *   4. 提供接口供其他模块获取偏移量
@@ -21,9 +21,20 @@
 #include "kmp.h"
 #include "peripherals.h"
 #include "osal.h"
+#include "pesudo_topic.h"
+#include "pesudo_sched.h"
 #include <stdio.h>
 #include <string.h>
 
+/*
+ * 工作数组: 双倍文本和 LPS 数组. 任务没有堆栈, 在主循环的堆栈上运行,
+ * 不能放在局部变量中, 每次运行从任务的 arena 分配, 运行结束后一起释放
+ */
+#define ALGO_TEM_BYTES      (sizeof(int) * 2 * RADAR_SCAN_ANGLES)
+#define ALGO_LPS_BYTES      (sizeof(int) * RADAR_SCAN_ANGLES)
+
+static topic_sub_t *m_scan_sub = NULL;      /* radar/scan 的订阅 */
+
 /*
  * detla_theta1 - 角度偏移量
  *
@@ -39,15 +50,18 @@ static int detla_theta1 = 0;
  *   接收雷达扫描数据，使用 KMP 算法进行匹配
  *
  * 执行流程:
- *   1. 获取消息队列句柄 (redar_to_algorithm)
- *   2. 接收 360 个角度的雷达数据 (每个角度 4 字节，合计 1440 字节)
- *   3. 复制数据作为当前扫描结果
- *   4. 构建双倍文本 (用于循环匹配):
- *      - tem[0~359] = angle_for_now[0~359]
- *      - tem[360~719] = angle_for_now[0~359]
- *   5. 构建 LPS 数组 (KMP 前缀表)
- *   6. 执行 KMP 搜索
- *   7. 保存匹配结果到 detla_theta1
+ *   1. 从 radar/scan 的订阅取出 360 个角度的雷达数据 (每个角度 3 字节，
+ *      合计 1080 字节), 没有数据时等待订阅, 任务返回
+ *      双倍文本和 LPS 数组从任务的 arena 分配
+ *   2. 转换为整数并构建双倍文本 (用于循环匹配):
+ *      - tem[0~359] = angle[0~359]
+ *      - tem[360~719] = angle[0~359]
+ *   3. 释放雷达数据的引用
+ *   4. 构建 LPS 数组 (KMP 前缀表)
+ *   5. 执行 KMP 搜索
+ *   6. 保存匹配结果到 detla_theta1
+ *
+ * 运行到完成的任务, 不阻塞, 没有自己的堆栈, 返回后 arena 被复位
  *
  * KMP 匹配原理:
  *   将雷达数据复制一份接在后面，形成 720 个元素
@@ -56,51 +70,58 @@ static int detla_theta1 = 0;
  */
 static void using_READAR_FOR_ROTATE_step2_task(void *arg)
 {
-    /* 当前扫描的角度数据 */
-    int angle_for_now[360] = {0};
-
-    /* 接收缓冲区 */
-    int angle[360] = {0};
+    int *tem;
+    int *lps;
+    const void *msg;
+    const uint8_t *angle;
+    void *objs[1];
 
-    /* 获取消息队列句柄 */
-    osal_mq_t q = peripherals_get_redar_to_algorithm();
-    if (!q) return;
+    topic_sub_t *sub = m_scan_sub;
+    if (!sub) return;
 
     /*
-     * 从队列接收雷达数据
-     * 数据格式: 360 个 32 位整数，合计 1440 字节
-     * 每个整数代表一个角度的测量值
+     * 取出雷达数据的引用, 不复制
+     * 数据格式: 360 x 3 字节，高字节在前，合计 1080 字节
      */
-    if (osal_mq_receive(q, angle, sizeof(angle), OSAL_WAIT_FOREVER) != 0) return;
+    if (topic_receive(sub, &msg) != OSAL_ERR_OK)
+    {
+        /* 有数据时再运行 */
+        objs[0] = sub;
+        osal_wait_any(objs, 1, OSAL_WAIT_FOREVER);
+        return;
+    }
 
-    /*
-     * 复制数据作为当前扫描结果
-     * angle_for_now 用于后续匹配
-     */
-    for (int i = 0; i < 360; i++)
+    tem = (int *)psched_task_arena_alloc(ALGO_TEM_BYTES);
+    lps = (int *)psched_task_arena_alloc(ALGO_LPS_BYTES);
+    if (!tem || !lps)
     {
-        angle_for_now[i] = angle[i];
+        topic_release(msg);
+        return;
     }
 
+    angle = (const uint8_t *)msg;
+
     /*
      * 构建双倍文本用于循环匹配
      * tem 数组大小: 720 (360 * 2)
      * 这样可以处理角度 359 -> 0 的循环情况
      */
-    int tem[720];
-    const int N = 360;  /* 模式/文本长度 */
-    const int M = 720;  /* 双倍文本长度 */
+    const int N = RADAR_SCAN_ANGLES;  /* 模式/文本长度 */
+    const int M = 2*N;                /* 双倍文本长度 */
 
-    /* 复制第一份 */
+    /* 第一份: DATA[0] << 16 | DATA[1] << 8 | DATA[2] */
     for (int i = 0; i < N; i++)
     {
-        tem[i] = angle_for_now[i];
+        tem[i] = (angle[3*i] << 16) | (angle[3*i+1] << 8) | angle[3*i+2];
     }
 
+    /* 数据已转换, 引用还给主题 */
+    topic_release(msg);
+
     /* 复制第二份 */
     for (int i = 0; i < N; i++)
     {
-        tem[i+N] = angle_for_now[i];
+        tem[i+N] = tem[i];
     }
 
     /*
@@ -108,13 +129,11 @@ static void using_READAR_FOR_ROTATE_step2_task(void *arg)
      * 1. 构建 LPS 数组 (Longest Prefix Suffix)
      * 2. 在双倍文本中搜索模式
      */
-    int lps[360];
-
-    /* 构建前缀表 */
-    kmp_build_lps(angle, N, lps);
+    /* 构建前缀表, 模式是 tem 的第一份 */
+    kmp_build_lps(tem, N, lps);
 
     /* 执行搜索，返回匹配位置 */
-    int match_start_index = kmp_search(tem, M, angle, N, lps);
+    int match_start_index = kmp_search(tem, M, tem, N, lps);
 
     /*
      * 保存匹配结果
@@ -128,17 +147,37 @@ static void using_READAR_FOR_ROTATE_step2_task(void *arg)
  * algorithms_init - 算法模块初始化
  *
  * 功能:
- *   创建算法处理任务
+ *   订阅 radar/scan 主题, 创建算法处理任务和它的 arena (工作数组)
+ *   队列深度 1, 只处理最新的一圈
  *
  * 任务参数:
  *   - 任务名: "redar_for_rotate"
- *   - 栈大小: 4096 字节
- *   - 优先级: 0 (最高)
+ *   - 运行到完成的任务, 没有任务栈
+ *   - 优先级: TASK_PRIO_ALGO
  *   - 入口函数: using_READAR_FOR_ROTATE_step2_task
  */
 void algorithms_init(void)
 {
-    osal_task_create("redar_for_rotate", 4096, 0, 0, using_READAR_FOR_ROTATE_step2_task, NULL);
+    m_scan_sub = topic_subscribe(topic_find(RADAR_TOPIC_SCAN), 1,
+                                 TOPIC_POLICY_DROP_OLDEST);
+    if (!m_scan_sub)
+    {
+        printk("Failed to subscribe %s\n", RADAR_TOPIC_SCAN);
+        return;
+    }
+
+    osal_task_t task = osal_task_create_rtc("redar_for_rotate", TASK_PRIO_ALGO,
+                                            using_READAR_FOR_ROTATE_step2_task, NULL);
+    if (!task)
+    {
+        printk("Failed to create task redar_for_rotate\n");
+        return;
+    }
+
+    if (psched_task_arena_create((psched_task_t *)task, ALGO_TEM_BYTES + ALGO_LPS_BYTES) != 0)
+    {
+        printk("Failed to create arena of redar_for_rotate\n");
+    }
 }
 
 /*
@@ -150,5 +189,5 @@ void algorithms_init(void)
  * 返回值:
  *   int: 角度偏移量 (0-359 表示有效值，-1 表示未匹配)
  */
-int algorithms_get_delta_theta(void) { return detla_theta1; }
-
+int algorithms_get_delta_theta(void) { return detla_theta1; }
+
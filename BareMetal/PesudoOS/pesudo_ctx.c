@@ -0,0 +1,287 @@
+/*
+ * pesudo_ctx.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "pesudo_ctx.h"
+#include "stable_counter.h"
+
+//-----------------------------------------------------------------------------
+
+extern void pesudo_ctx_start(void);
+
+#if __loongarch64
+
+/*
+ * regs[]: 0 ra, 1 sp, 2 fp, 3~11 s0~s8, 12~19 fs0~fs7
+ */
+#if PESUDO_CTX_SAVE_FP
+#define CTX_FP_SAVE                             \
+    "    fst.d   $fs0, $a0, 96          \n"     \
+    "    fst.d   $fs1, $a0, 104         \n"     \
+    "    fst.d   $fs2, $a0, 112         \n"     \
+    "    fst.d   $fs3, $a0, 120         \n"     \
+    "    fst.d   $fs4, $a0, 128         \n"     \
+    "    fst.d   $fs5, $a0, 136         \n"     \
+    "    fst.d   $fs6, $a0, 144         \n"     \
+    "    fst.d   $fs7, $a0, 152         \n"
+#define CTX_FP_LOAD                             \
+    "    fld.d   $fs0, $a1, 96          \n"     \
+    "    fld.d   $fs1, $a1, 104         \n"     \
+    "    fld.d   $fs2, $a1, 112         \n"     \
+    "    fld.d   $fs3, $a1, 120         \n"     \
+    "    fld.d   $fs4, $a1, 128         \n"     \
+    "    fld.d   $fs5, $a1, 136         \n"     \
+    "    fld.d   $fs6, $a1, 144         \n"     \
+    "    fld.d   $fs7, $a1, 152         \n"
+#else
+#define CTX_FP_SAVE
+#define CTX_FP_LOAD
+#endif
+
+__asm__(
+    "    .text                          \n"
+    "    .align  3                      \n"
+    "    .globl  pesudo_ctx_switch      \n"
+    "    .type   pesudo_ctx_switch, @function \n"
+    "pesudo_ctx_switch:                 \n"
+    "    st.d    $ra, $a0, 0            \n"
+    "    st.d    $sp, $a0, 8            \n"
+    "    st.d    $fp, $a0, 16           \n"
+    "    st.d    $s0, $a0, 24           \n"
+    "    st.d    $s1, $a0, 32           \n"
+    "    st.d    $s2, $a0, 40           \n"
+    "    st.d    $s3, $a0, 48           \n"
+    "    st.d    $s4, $a0, 56           \n"
+    "    st.d    $s5, $a0, 64           \n"
+    "    st.d    $s6, $a0, 72           \n"
+    "    st.d    $s7, $a0, 80           \n"
+    "    st.d    $s8, $a0, 88           \n"
+    CTX_FP_SAVE
+    "    ld.d    $ra, $a1, 0            \n"
+    "    ld.d    $sp, $a1, 8            \n"
+    "    ld.d    $fp, $a1, 16           \n"
+    "    ld.d    $s0, $a1, 24           \n"
+    "    ld.d    $s1, $a1, 32           \n"
+    "    ld.d    $s2, $a1, 40           \n"
+    "    ld.d    $s3, $a1, 48           \n"
+    "    ld.d    $s4, $a1, 56           \n"
+    "    ld.d    $s5, $a1, 64           \n"
+    "    ld.d    $s6, $a1, 72           \n"
+    "    ld.d    $s7, $a1, 80           \n"
+    "    ld.d    $s8, $a1, 88           \n"
+    CTX_FP_LOAD
+    "    jr      $ra                    \n"
+    "    .size   pesudo_ctx_switch, .-pesudo_ctx_switch \n"
+    "                                   \n"
+    /*
+     * s0 = entry, s1 = arg
+     */
+    "    .align  3                      \n"
+    "    .type   pesudo_ctx_start, @function \n"
+    "pesudo_ctx_start:                  \n"
+    "    move    $a0, $s1               \n"
+    "    jirl    $ra, $s0, 0            \n"
+    "    bl      pesudo_ctx_exit        \n"
+    "    .size   pesudo_ctx_start, .-pesudo_ctx_start \n"
+);
+
+void pesudo_ctx_init(pesudo_ctx_t *ctx, void *stack, size_t stack_size,
+                     pesudo_ctx_entry_t entry, void *arg)
+{
+    memset(ctx, 0, sizeof(pesudo_ctx_t));
+
+    ctx->regs[0] = (uint64_t)pesudo_ctx_start;
+    ctx->regs[1] = ((uint64_t)stack + stack_size) & ~15ULL;
+    ctx->regs[3] = (uint64_t)entry;
+    ctx->regs[4] = (uint64_t)arg;
+}
+
+#elif defined(__x86_64__)
+
+/*
+ * Host build. regs[]: 0 rip, 1 rsp, 2 rbp, 3 rbx, 4~7 r12~r15, 8 mxcsr + x87 cw
+ */
+__asm__(
+    "    .text                          \n"
+    "    .p2align 4                     \n"
+    "    .globl  pesudo_ctx_switch      \n"
+    "    .type   pesudo_ctx_switch, @function \n"
+    "pesudo_ctx_switch:                 \n"
+    "    movq    (%rsp), %rax           \n"
+    "    movq    %rax, 0(%rdi)          \n"
+    "    leaq    8(%rsp), %rax          \n"
+    "    movq    %rax, 8(%rdi)          \n"
+    "    movq    %rbp, 16(%rdi)         \n"
+    "    movq    %rbx, 24(%rdi)         \n"
+    "    movq    %r12, 32(%rdi)         \n"
+    "    movq    %r13, 40(%rdi)         \n"
+    "    movq    %r14, 48(%rdi)         \n"
+    "    movq    %r15, 56(%rdi)         \n"
+    "    stmxcsr 64(%rdi)               \n"
+    "    fnstcw  68(%rdi)               \n"
+    "    movq    16(%rsi), %rbp         \n"
+    "    movq    24(%rsi), %rbx         \n"
+    "    movq    32(%rsi), %r12         \n"
+    "    movq    40(%rsi), %r13         \n"
+    "    movq    48(%rsi), %r14         \n"
+    "    movq    56(%rsi), %r15         \n"
+    "    ldmxcsr 64(%rsi)               \n"
+    "    fldcw   68(%rsi)               \n"
+    "    movq    8(%rsi), %rsp          \n"
+    "    jmpq    *0(%rsi)               \n"
+    "    .size   pesudo_ctx_switch, .-pesudo_ctx_switch \n"
+    "                                   \n"
+    /*
+     * rbx = entry, r12 = arg
+     */
+    "    .p2align 4                     \n"
+    "    .type   pesudo_ctx_start, @function \n"
+    "pesudo_ctx_start:                  \n"
+    "    movq    %r12, %rdi             \n"
+    "    callq   *%rbx                  \n"
+    "    callq   pesudo_ctx_exit@PLT    \n"
+    "    ud2                            \n"
+    "    .size   pesudo_ctx_start, .-pesudo_ctx_start \n"
+);
+
+void pesudo_ctx_init(pesudo_ctx_t *ctx, void *stack, size_t stack_size,
+                     pesudo_ctx_entry_t entry, void *arg)
+{
+    memset(ctx, 0, sizeof(pesudo_ctx_t));
+
+    ctx->regs[0] = (uint64_t)pesudo_ctx_start;
+    ctx->regs[1] = ((uint64_t)stack + stack_size) & ~15ULL;
+    ctx->regs[3] = (uint64_t)entry;
+    ctx->regs[4] = (uint64_t)arg;
+    ctx->regs[8] = 0x1F80 | (0x037FULL << 32);  /* 默认 mxcsr, x87 cw */
+}
+
+#else
+#error "pesudo_ctx: unsupported cpu"
+#endif
+
+/*
+ * pesudo_sched.c 中实现. 没有时停在这里
+ */
+void __attribute__((weak)) pesudo_ctx_exit(void)
+{
+    for (;;)
+        ;
+}
+
+//-----------------------------------------------------------------------------
+// Benchmark
+//-----------------------------------------------------------------------------
+
+#define BENCH_STACK_SIZE        4096
+
+static pesudo_ctx_t m_main_ctx, m_co_ctx;
+static jmp_buf m_main_jb, m_co_jb;
+
+static void bench_ctx_co(void *arg)
+{
+    (void)arg;
+
+    for (;;)
+    {
+        pesudo_ctx_switch(&m_co_ctx, &m_main_ctx);
+    }
+}
+
+/*
+ * 和 PesudoOS 相同: setjmp() 保存位置, longjmp() 到对方
+ */
+static void bench_jmp_co(void *arg)
+{
+    (void)arg;
+
+    if (!setjmp(m_co_jb))
+    {
+        pesudo_ctx_switch(&m_co_ctx, &m_main_ctx);
+    }
+
+    for (;;)
+    {
+        if (!setjmp(m_co_jb))
+        {
+            longjmp(m_main_jb, 1);
+        }
+    }
+}
+
+/*
+ * 只有 volatile 的 i 跨过 setjmp(), 计时的变量在调用者中, 不会被 longjmp() 破坏
+ */
+static __attribute__((noinline)) void bench_jmp_loop(uint32_t loops)
+{
+    volatile uint32_t i;
+
+    for (i = 0; i < loops; i++)
+    {
+        if (!setjmp(m_main_jb))
+        {
+            longjmp(m_co_jb, 1);
+        }
+    }
+}
+
+int pesudo_ctx_bench(uint32_t loops, pesudo_ctx_bench_t *result)
+{
+    volatile uint32_t i;
+    uint64_t begin, used;
+    void *stack;
+
+    if (!result || (loops == 0))
+    {
+        return -1;
+    }
+
+    stack = malloc(BENCH_STACK_SIZE);
+    if (!stack)
+    {
+        return -1;
+    }
+
+    result->loops = loops;
+
+    /*
+     * pesudo_ctx_switch
+     */
+    pesudo_ctx_init(&m_co_ctx, stack, BENCH_STACK_SIZE, bench_ctx_co, NULL);
+
+    begin = stable_counter_read();
+    for (i = 0; i < loops; i++)
+    {
+        pesudo_ctx_switch(&m_main_ctx, &m_co_ctx);
+    }
+    used = stable_counter_read() - begin;
+
+    result->ctx_ns = (uint32_t)(stable_counter_to_ns(used) / (2 * (uint64_t)loops));
+
+    /*
+     * setjmp + longjmp
+     */
+    pesudo_ctx_init(&m_co_ctx, stack, BENCH_STACK_SIZE, bench_jmp_co, NULL);
+    pesudo_ctx_switch(&m_main_ctx, &m_co_ctx);
+
+    begin = stable_counter_read();
+    bench_jmp_loop(loops);
+    used = stable_counter_read() - begin;
+
+    result->jmp_ns = (uint32_t)(stable_counter_to_ns(used) / (2 * (uint64_t)loops));
+
+    free(stack);
+
+    return 0;
+}
+
+/*
+ * @@ END
+ */
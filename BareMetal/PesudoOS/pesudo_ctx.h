@@ -0,0 +1,82 @@
+/*
+ * pesudo_ctx.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Task context switch.
+ *
+ * pesudo_ctx_switch() saves the callee-saved registers of the ABI to "from"
+ * and loads "to", a switch is one function call, instead of setjmp() and
+ * longjmp() of the whole jmp_buf.
+ *
+ *   LoongArch64: ra, sp, fp, s0-s8; fs0-fs7 if PESUDO_CTX_SAVE_FP
+ *   x86-64:      return address, rsp, rbp, rbx, r12-r15, mxcsr, x87 cw
+ *
+ * lp64d ABI need fs0-fs7. PESUDO_CTX_SAVE_FP can be 0 only if no floating
+ * point value lives across a switch in all tasks.
+ */
+
+#ifndef _PESUDO_CTX_H
+#define _PESUDO_CTX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+
+#ifndef PESUDO_CTX_SAVE_FP
+#define PESUDO_CTX_SAVE_FP      1
+#endif
+
+#define PESUDO_CTX_REGS         20
+
+typedef struct pesudo_ctx
+{
+    uint64_t regs[PESUDO_CTX_REGS];
+} pesudo_ctx_t;
+
+typedef void (*pesudo_ctx_entry_t)(void *arg);
+
+/*
+ * the first switch to ctx call entry(arg) on the stack. When entry return,
+ * pesudo_ctx_exit() is called, it must not return.
+ */
+void pesudo_ctx_init(pesudo_ctx_t *ctx, void *stack, size_t stack_size,
+                     pesudo_ctx_entry_t entry, void *arg);
+
+void pesudo_ctx_switch(pesudo_ctx_t *from, pesudo_ctx_t *to);
+
+void pesudo_ctx_exit(void);
+
+//-----------------------------------------------------------------------------
+// Benchmark
+//-----------------------------------------------------------------------------
+
+typedef struct pesudo_ctx_bench
+{
+    uint32_t loops;                             /* 来回次数 */
+    uint32_t ctx_ns;                            /* pesudo_ctx_switch() 一次 */
+    uint32_t jmp_ns;                            /* setjmp() + longjmp() 一次 */
+} pesudo_ctx_bench_t;
+
+/*
+ * ping-pong with a context on its own stack, loops round trips of each way.
+ */
+int pesudo_ctx_bench(uint32_t loops, pesudo_ctx_bench_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_CTX_H
+
+/*
+ * @@ END
+ */
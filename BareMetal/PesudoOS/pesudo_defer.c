@@ -0,0 +1,345 @@
+/*
+ * pesudo_defer.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include <string.h>
+
+#include "osal.h"
+#include "pesudo_waitq.h"
+#include "pesudo_idle.h"
+#include "pesudo_defer.h"
+
+//-----------------------------------------------------------------------------
+
+enum
+{
+    DEFER_SEM_RELEASE = 1,
+    DEFER_EVENT_SEND,
+    DEFER_MQ_SEND,
+    DEFER_OSAL_SEM_RELEASE,
+    DEFER_OSAL_EVENT_SEND,
+    DEFER_OSAL_MQ_SEND,
+    DEFER_CALL,
+};
+
+typedef struct defer_op
+{
+    uint16_t op;
+    uint16_t size;                              /* mq 消息长度 */
+    uint32_t bits;                              /* event */
+    void    *obj;
+    union
+    {
+        void   (*func)(void *arg);              /* DEFER_CALL, arg 是 obj */
+        uint8_t  msg[PESUDO_DEFER_MSG_SIZE];
+    } u;
+} defer_op_t;
+
+/*
+ * head 只由 drain 修改, tail 只由 isr 修改. 都是自由计数, 用时取模
+ */
+typedef struct defer_ring
+{
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    defer_op_t        ops[PESUDO_DEFER_SIZE];
+
+    volatile uint32_t posted;
+    volatile uint32_t overflow;
+    volatile uint32_t max_used;
+    uint32_t          done;
+} defer_ring_t;
+
+static defer_ring_t m_ring[PESUDO_DEFER_CPUS];
+
+#if __loongarch64
+#define DEFER_BARRIER()     __asm__ __volatile__("dbar 0" ::: "memory")
+#else
+#define DEFER_BARRIER()     __sync_synchronize()
+#endif
+
+static inline defer_ring_t *this_ring(void)
+{
+#if (PESUDO_DEFER_CPUS > 1) && __loongarch64
+    unsigned long id;
+    __asm__ __volatile__("csrrd %0, 0x20" : "=r"(id));      /* CSR.CPUID */
+    return &m_ring[(id & 0x1FF) % PESUDO_DEFER_CPUS];
+#else
+    return &m_ring[0];
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// producer, in isr
+//-----------------------------------------------------------------------------
+
+/*
+ * 取得空位置, 填写后 post_commit()
+ */
+static inline defer_op_t *post_begin(defer_ring_t *ring)
+{
+    uint32_t used = ring->tail - ring->head;
+
+    if (used >= PESUDO_DEFER_SIZE)
+    {
+        ring->overflow++;
+        return NULL;
+    }
+
+    if (used + 1 > ring->max_used)
+    {
+        ring->max_used = used + 1;
+    }
+
+    return &ring->ops[ring->tail & (PESUDO_DEFER_SIZE - 1)];
+}
+
+static inline int post_commit(defer_ring_t *ring)
+{
+    /*
+     * 先写入内容, 再移动 tail
+     */
+    DEFER_BARRIER();
+    ring->tail++;
+    ring->posted++;
+
+    pesudo_idle_kick();
+
+    return 0;
+}
+
+static int post_obj(uint16_t op, void *obj, uint32_t bits)
+{
+    defer_ring_t *ring = this_ring();
+    defer_op_t *d;
+
+    if (!obj || !(d = post_begin(ring)))
+    {
+        return -1;
+    }
+
+    d->op   = op;
+    d->obj  = obj;
+    d->bits = bits;
+    d->size = 0;
+
+    return post_commit(ring);
+}
+
+static int post_msg(uint16_t op, void *obj, const void *msg, int size)
+{
+    defer_ring_t *ring = this_ring();
+    defer_op_t *d;
+
+    if (!obj || !msg || (size <= 0) || (size > PESUDO_DEFER_MSG_SIZE))
+    {
+        return -1;
+    }
+
+    if (!(d = post_begin(ring)))
+    {
+        return -1;
+    }
+
+    d->op   = op;
+    d->obj  = obj;
+    d->bits = 0;
+    d->size = (uint16_t)size;
+    memcpy(d->u.msg, msg, size);
+
+    return post_commit(ring);
+}
+
+int pesudo_defer_sem_release(void *sem)
+{
+    return post_obj(DEFER_SEM_RELEASE, sem, 0);
+}
+
+int pesudo_defer_event_send(void *event, uint32_t bits)
+{
+    return post_obj(DEFER_EVENT_SEND, event, bits);
+}
+
+int pesudo_defer_mq_send(void *mq, const void *msg, int size)
+{
+    return post_msg(DEFER_MQ_SEND, mq, msg, size);
+}
+
+int pesudo_defer_osal_sem_release(void *sem)
+{
+    return post_obj(DEFER_OSAL_SEM_RELEASE, sem, 0);
+}
+
+int pesudo_defer_osal_event_send(void *event, uint32_t bits)
+{
+    return post_obj(DEFER_OSAL_EVENT_SEND, event, bits);
+}
+
+int pesudo_defer_osal_mq_send(void *mq, const void *msg, int size)
+{
+    return post_msg(DEFER_OSAL_MQ_SEND, mq, msg, size);
+}
+
+int pesudo_defer_call(void (*func)(void *arg), void *arg)
+{
+    defer_ring_t *ring = this_ring();
+    defer_op_t *d;
+
+    if (!func || !(d = post_begin(ring)))
+    {
+        return -1;
+    }
+
+    d->op     = DEFER_CALL;
+    d->obj    = arg;
+    d->u.func = func;
+
+    return post_commit(ring);
+}
+
+//-----------------------------------------------------------------------------
+// consumer, in main loop
+//-----------------------------------------------------------------------------
+
+static void defer_do(defer_op_t *d)
+{
+    switch (d->op)
+    {
+        case DEFER_SEM_RELEASE:
+            psched_sem_release((psched_sem_t *)d->obj);
+            break;
+
+        case DEFER_EVENT_SEND:
+            psched_event_send((psched_event_t *)d->obj, d->bits);
+            break;
+
+        case DEFER_MQ_SEND:
+            psched_mq_send((psched_mq_t *)d->obj, d->u.msg, d->size);
+            break;
+
+        case DEFER_OSAL_SEM_RELEASE:
+            osal_sem_release((osal_sem_t)d->obj);
+            break;
+
+        case DEFER_OSAL_EVENT_SEND:
+            osal_event_send((osal_event_t)d->obj, d->bits);
+            break;
+
+        case DEFER_OSAL_MQ_SEND:
+            osal_mq_send((osal_mq_t)d->obj, d->u.msg, d->size);
+            break;
+
+        case DEFER_CALL:
+            d->u.func(d->obj);
+            break;
+
+        default:
+            break;
+    }
+}
+
+int pesudo_defer_drain(void)
+{
+    defer_ring_t *ring;
+    uint32_t head, tail, n;
+    int i, count = 0;
+
+    for (i = 0; i < PESUDO_DEFER_CPUS; i++)
+    {
+        ring = &m_ring[i];
+        head = ring->head;
+        tail = ring->tail;
+
+        if (head == tail)
+        {
+            continue;
+        }
+
+        /*
+         * 读到 tail 之后再读内容
+         */
+        DEFER_BARRIER();
+
+        n = tail - head;
+        while (head != tail)
+        {
+            defer_op_t op = ring->ops[head & (PESUDO_DEFER_SIZE - 1)];
+
+            /*
+             * 复制出来后释放位置, 执行中 isr 可以再加入
+             */
+            DEFER_BARRIER();
+            ring->head = ++head;
+
+            defer_do(&op);
+        }
+
+        ring->done += n;
+        count += (int)n;
+    }
+
+    return count;
+}
+
+int pesudo_defer_pending(void)
+{
+    int i;
+
+    for (i = 0; i < PESUDO_DEFER_CPUS; i++)
+    {
+        if (m_ring[i].head != m_ring[i].tail)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void pesudo_defer_stats(pesudo_defer_stats_t *stats)
+{
+    int i;
+
+    if (!stats)
+    {
+        return;
+    }
+
+    memset(stats, 0, sizeof(pesudo_defer_stats_t));
+
+    for (i = 0; i < PESUDO_DEFER_CPUS; i++)
+    {
+        stats->posted   += m_ring[i].posted;
+        stats->done     += m_ring[i].done;
+        stats->overflow += m_ring[i].overflow;
+        if (m_ring[i].max_used > stats->max_used)
+        {
+            stats->max_used = m_ring[i].max_used;
+        }
+    }
+}
+
+void pesudo_defer_stats_reset(void)
+{
+    size_t flag;
+    int i;
+
+    flag = osal_enter_critical_section();
+
+    for (i = 0; i < PESUDO_DEFER_CPUS; i++)
+    {
+        m_ring[i].posted   = 0;
+        m_ring[i].done     = 0;
+        m_ring[i].overflow = 0;
+        m_ring[i].max_used = 0;
+    }
+
+    osal_leave_critical_section(flag);
+}
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,92 @@
+/*
+ * pesudo_defer.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Deferred operations from interrupt.
+ *
+ * The signal of an object in isr is "processed later" (PesudoOS 0.2). Here an
+ * isr post the operation to a single-producer/single-consumer ring, without
+ * critical section, and pesudo_sched_run() drain the ring at the beginning of
+ * a pass, the operation is done in the main loop:
+ *
+ *     static void dma_done_isr(int vector, void *arg)
+ *     {
+ *         pesudo_defer_sem_release(m_tx_done);
+ *     }
+ *
+ * The producer is the interrupt of the cpu, the interrupts of LS2K300 don't
+ * nest, so there is one producer for a ring. Tasks call the operations
+ * directly, never these.
+ *
+ * When the ring is full the operation is dropped and counted in overflow.
+ */
+
+#ifndef _PESUDO_DEFER_H
+#define _PESUDO_DEFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+
+#define PESUDO_DEFER_CPUS       1               /* 每个 cpu 一个队列 */
+#define PESUDO_DEFER_SIZE       64              /* 队列长度, 2 的幂 */
+#define PESUDO_DEFER_MSG_SIZE   16              /* mq 消息的最大长度 */
+
+#if (PESUDO_DEFER_SIZE & (PESUDO_DEFER_SIZE - 1))
+#error "PESUDO_DEFER_SIZE must be power of 2"
+#endif
+
+typedef struct pesudo_defer_stats
+{
+    uint32_t posted;                            /* 加入次数 */
+    uint32_t done;                              /* 执行次数 */
+    uint32_t overflow;                          /* 队列满丢弃次数 */
+    uint32_t max_used;                          /* 最多排队个数 */
+} pesudo_defer_stats_t;
+
+/*
+ * objects of pesudo_waitq.h, return 0 or -1 if the ring is full
+ */
+int pesudo_defer_sem_release(void *sem);
+int pesudo_defer_event_send(void *event, uint32_t bits);
+int pesudo_defer_mq_send(void *mq, const void *msg, int size);
+
+/*
+ * objects of osal (libbsp)
+ */
+int pesudo_defer_osal_sem_release(void *sem);
+int pesudo_defer_osal_event_send(void *event, uint32_t bits);
+int pesudo_defer_osal_mq_send(void *mq, const void *msg, int size);
+
+/*
+ * call func(arg) in the main loop
+ */
+int pesudo_defer_call(void (*func)(void *arg), void *arg);
+
+/*
+ * called by pesudo_sched_run(), return the count of done operations
+ */
+int pesudo_defer_drain(void);
+
+int pesudo_defer_pending(void);
+
+void pesudo_defer_stats(pesudo_defer_stats_t *stats);
+void pesudo_defer_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_DEFER_H
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,287 @@
+/*
+ * pesudo_idle.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#if !__loongarch64
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#include "osal.h"
+#include "pesudoos.h"
+#include "pesudo_task.h"
+#include "pesudo_sched.h"
+#include "pesudo_defer.h"
+#include "pesudo_idle.h"
+#include "stable_counter.h"
+
+//-----------------------------------------------------------------------------
+
+static volatile int m_kicked = 0;
+
+static uint64_t m_stats_begin = 0;
+static pesudo_idle_stats_t m_stats;
+
+//-----------------------------------------------------------------------------
+// wakeup timer, src/hal/hpet 中实现
+//-----------------------------------------------------------------------------
+
+int __attribute__((weak)) pesudo_idle_timer_arm(uint32_t us)
+{
+    (void)us;
+    return -1;
+}
+
+void __attribute__((weak)) pesudo_idle_timer_cancel(void)
+{
+}
+
+//-----------------------------------------------------------------------------
+// CPU wait
+//-----------------------------------------------------------------------------
+
+#if __loongarch64
+
+void pesudo_idle_kick(void)
+{
+    m_kicked = 1;
+}
+
+/*
+ * 等待中断, 中断返回后继续
+ *
+ * 关中断后最后检查一次 kick 和 defer: 检查之后的中断保持挂起, 仍然唤醒
+ * idle, 开中断后再响应, 不会睡到下一个定时
+ */
+static void idle_cpu_wait(uint64_t deadline)
+{
+    size_t flag;
+
+    (void)deadline;
+
+    flag = osal_enter_critical_section();
+
+    if (!m_kicked && !pesudo_defer_pending())
+    {
+        __asm__ __volatile__("idle 0" ::: "memory");
+    }
+
+    osal_leave_critical_section(flag);
+}
+
+#else
+
+static pthread_mutex_t m_idle_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  m_idle_cond = PTHREAD_COND_INITIALIZER;
+
+void pesudo_idle_kick(void)
+{
+    pthread_mutex_lock(&m_idle_lock);
+    m_kicked = 1;
+    pthread_cond_signal(&m_idle_cond);
+    pthread_mutex_unlock(&m_idle_lock);
+}
+
+static void idle_cpu_wait(uint64_t deadline)
+{
+    uint64_t now = get_clock_ticks();
+    struct timespec ts;
+
+    if ((int64_t)(deadline - now) <= 0)
+    {
+        return;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec  += (deadline - now) / 1000;
+    ts.tv_nsec += (long)((deadline - now) % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&m_idle_lock);
+    while (!m_kicked && !pesudo_defer_pending())
+    {
+        if (pthread_cond_timedwait(&m_idle_cond, &m_idle_lock, &ts) == ETIMEDOUT)
+        {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&m_idle_lock);
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+// next tick
+//-----------------------------------------------------------------------------
+
+static inline void tick_min(uint64_t *tick, uint64_t val)
+{
+    if (val < *tick)
+    {
+        *tick = val;
+    }
+}
+
+/*
+ * libbsp 的任务: 就绪返回 0; blocked 是否有任务阻塞在对象上
+ */
+static uint64_t pesudoos_next_tick(uint64_t now, int *blocked)
+{
+    struct pesudo_task *task;
+    uint64_t tick = PSCHED_TICK_NEVER;
+    uint32_t state;
+
+    *blocked = 0;
+
+    for (task = pesudoos_task_list_first(); task != NULL;
+         task = pesudoos_task_list_next(task))
+    {
+        state = task->state;
+
+        if (state & PT_STATE_SUSPEND)
+        {
+            continue;
+        }
+
+        if (state & PT_STATE_SLEEP)
+        {
+            tick_min(&tick, task->sleep_until);
+        }
+        else if (IS_BLOCKED(state))
+        {
+            *blocked = 1;
+
+            if (task->block_until)
+            {
+                tick_min(&tick, task->block_until);
+            }
+        }
+        else if (state & PT_STATE_IDLE)
+        {
+            tick_min(&tick, task->first_run_until);
+        }
+        else
+        {
+            return 0;
+        }
+
+        /*
+         * libbsp 的 Timer 到期时间不可见, 按最小定时检查
+         */
+        if (task->p_timer)
+        {
+            tick_min(&tick, now + PESUDO_TIMER_MS_MIN);
+        }
+    }
+
+    return tick;
+}
+
+//-----------------------------------------------------------------------------
+
+void pesudo_idle(void)
+{
+    uint64_t now, deadline, begin, used;
+    int blocked, armed;
+
+    if (m_stats_begin == 0)
+    {
+        m_stats_begin = stable_counter_read();
+    }
+
+    /*
+     * 先清除, 检查之后的 kick 不会丢失
+     */
+    m_kicked = 0;
+
+    now = get_clock_ticks();
+
+    deadline = pesudo_sched_next_tick();
+    tick_min(&deadline, pesudoos_next_tick(now, &blocked));
+
+    if (deadline <= now)
+    {
+        return;
+    }
+
+    /*
+     * 计算期间中断投递的工作, 不再等待
+     */
+    if (m_kicked || pesudo_defer_pending())
+    {
+        return;
+    }
+
+    if (deadline - now > PESUDO_IDLE_MAX_MS)
+    {
+        deadline = now + PESUDO_IDLE_MAX_MS;
+    }
+
+    armed = (pesudo_idle_timer_arm((uint32_t)(deadline - now) * 1000) == 0);
+
+    begin = stable_counter_read();
+
+    for (;;)
+    {
+        idle_cpu_wait(deadline);
+
+        if (m_kicked || blocked)
+        {
+            break;
+        }
+
+        /*
+         * 中断中可能唤醒了 pesudo_sched 的任务
+         */
+        now = get_clock_ticks();
+        if ((deadline <= now) || (pesudo_sched_next_tick() <= now))
+        {
+            break;
+        }
+    }
+
+    used = stable_counter_to_us(stable_counter_read() - begin);
+
+    if (armed)
+    {
+        pesudo_idle_timer_cancel();
+    }
+
+    m_stats.idle_us += used;
+    m_stats.idle_count++;
+    if (used > m_stats.idle_max_us)
+    {
+        m_stats.idle_max_us = (uint32_t)used;
+    }
+}
+
+void pesudo_idle_stats(pesudo_idle_stats_t *stats)
+{
+    if (stats)
+    {
+        *stats = m_stats;
+        stats->total_us = m_stats_begin ?
+                          stable_counter_to_us(stable_counter_read() - m_stats_begin) : 0;
+    }
+}
+
+void pesudo_idle_stats_reset(void)
+{
+    memset(&m_stats, 0, sizeof(m_stats));
+    m_stats_begin = stable_counter_read();
+}
+
+/*
+ * @@ END
+ */
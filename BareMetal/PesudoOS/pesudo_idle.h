@@ -0,0 +1,77 @@
+/*
+ * pesudo_idle.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Idle of the main loop.
+ *
+ * pesudo_idle() is called after pesudo_sched_run() and pesudoos_run(0). It
+ * finds the next tick something has to run: the ready tasks and the timing
+ * wheel of pesudo_sched, the ready, sleeping and timeout blocked tasks of
+ * libbsp. Then the CPU wait for interrupt ("idle 0") until that tick, instead
+ * of spinning the loop. The last check of pesudo_idle_kick() and the deferred
+ * work from ISR is done with interrupt disabled, right before "idle 0"; a post
+ * after it keep pending and still wake the CPU.
+ *
+ * pesudo_idle_timer_arm() program a wakeup at the deadline (HPET, see
+ * src/hal/hpet). Without it, the system tick interrupt wake the CPU.
+ *
+ * libbsp tasks blocked on an object are waked by pesudoos_run() only, so when
+ * one is blocked, the idle return after any interrupt.
+ *
+ * On host build (not LoongArch) the wait is a timed wait of a condition,
+ * pesudo_idle_kick() signal it.
+ */
+
+#ifndef _PESUDO_IDLE_H
+#define _PESUDO_IDLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+
+#define PESUDO_IDLE_MAX_MS      1000        /* 最长一次空闲 */
+
+typedef struct pesudo_idle_stats
+{
+    uint64_t total_us;                      /* 统计时长 */
+    uint64_t idle_us;                       /* 空闲时长 */
+    uint32_t idle_count;                    /* 空闲次数 */
+    uint32_t idle_max_us;                   /* 最长一次空闲 */
+} pesudo_idle_stats_t;
+
+/*
+ * wait until next task or timer is ready, or an interrupt
+ */
+void pesudo_idle(void);
+
+/*
+ * end the idle, called by interrupt or other thread when makes a task ready
+ */
+void pesudo_idle_kick(void);
+
+void pesudo_idle_stats(pesudo_idle_stats_t *stats);
+void pesudo_idle_stats_reset(void);
+
+/*
+ * wakeup timer, the weak default do nothing and return -1
+ */
+int  pesudo_idle_timer_arm(uint32_t us);
+void pesudo_idle_timer_cancel(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_IDLE_H
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,115 @@
+/*
+ * pesudo_prof.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include <string.h>
+
+#include "osal.h"
+#include "pesudo_prof.h"
+#include "pesudo_task.h"
+#include "stable_counter.h"
+
+//-----------------------------------------------------------------------------
+
+static void psched_stats(psched_task_t *task, pesudoos_task_stats_t *st, uint64_t now)
+{
+    psched_prof_t *prof = &task->prof;
+    int i;
+
+    st->task  = task;
+    st->kind  = PESUDO_STATS_PSCHED;
+    st->prio  = task->prio;
+    st->state = task->state;
+    strncpy(st->name, task->name, PESUDO_NAME_MAX - 1);
+
+    st->run_count   = task->run_count;
+    st->run_us      = stable_counter_to_us(prof->run_time);
+    st->run_max_us  = (uint32_t)stable_counter_to_us(prof->run_max);
+
+    st->wake_count  = prof->wake_count;
+    st->wake_us     = stable_counter_to_us(prof->wake_time);
+    st->wake_max_us = (uint32_t)stable_counter_to_us(prof->wake_max);
+
+    for (i=0; i<PSCHED_BLOCK_TYPES; i++)
+    {
+        st->block_us[i] = stable_counter_to_us(prof->block_time[i]);
+    }
+
+    /*
+     * 正在阻塞
+     */
+    if (prof->block_at)
+    {
+        st->block_us[prof->block_type] += stable_counter_to_us(now - prof->block_at);
+    }
+}
+
+static void libbsp_stats(struct pesudo_task *task, pesudoos_task_stats_t *st)
+{
+    st->task  = task;
+    st->kind  = PESUDO_STATS_LIBBSP;
+    st->state = task->state;
+    strncpy(st->name, task->task_name, PESUDO_NAME_MAX - 1);
+
+    st->run_count = task->run_count;
+    st->run_us    = (uint64_t)task->run_ticks * 1000;
+}
+
+int pesudoos_task_stats(pesudoos_task_stats_t *stats, int max)
+{
+    psched_task_t *pt;
+    struct pesudo_task *lt;
+    uint64_t now;
+    size_t flag;
+    int count = 0;
+
+    if (!stats || (max <= 0))
+    {
+        return 0;
+    }
+
+    memset(stats, 0, sizeof(pesudoos_task_stats_t) * max);
+
+    flag = osal_enter_critical_section();
+
+    now = stable_counter_read();
+
+    for (pt = psched_task_list_first(); pt && (count < max);
+         pt = psched_task_list_next(pt))
+    {
+        psched_stats(pt, &stats[count++], now);
+    }
+
+    for (lt = pesudoos_task_list_first(); lt && (count < max);
+         lt = pesudoos_task_list_next(lt))
+    {
+        libbsp_stats(lt, &stats[count++]);
+    }
+
+    osal_leave_critical_section(flag);
+
+    return count;
+}
+
+void pesudoos_task_stats_reset_max(void)
+{
+    psched_task_t *pt;
+    size_t flag;
+
+    flag = osal_enter_critical_section();
+
+    for (pt = psched_task_list_first(); pt; pt = psched_task_list_next(pt))
+    {
+        pt->prof.run_max  = 0;
+        pt->prof.wake_max = 0;
+    }
+
+    osal_leave_critical_section(flag);
+}
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,75 @@
+/*
+ * pesudo_prof.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Task runtime statistics.
+ *
+ * The tasks of pesudo_sched are measured by the stable counter in dispatch:
+ * cpu time, longest run, wakeup latency (ready to running) and block time by
+ * the type waited. It costs two reads of the counter for a run.
+ *
+ * The tasks of libbsp have only run_count and run_ticks (ms) of struct
+ * pesudo_task, they are reported as is, the others are 0.
+ *
+ * The counters are total since the task is created, the caller takes the
+ * difference of two samples, as the shell "top" command.
+ */
+
+#ifndef _PESUDO_PROF_H
+#define _PESUDO_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "pesudo_sched.h"
+
+//-----------------------------------------------------------------------------
+
+#define PESUDO_STATS_PSCHED     1               /* pesudo_sched 任务 */
+#define PESUDO_STATS_LIBBSP     2               /* libbsp 任务, ms 精度 */
+
+typedef struct pesudoos_task_stats
+{
+    const void *task;                           /* 任务, 用于对比两次采样 */
+    char      name[PESUDO_NAME_MAX];
+    uint32_t  kind;                             /* PESUDO_STATS_* */
+    uint32_t  prio;
+    uint32_t  state;
+
+    uint32_t  run_count;                        /* 运行次数 */
+    uint64_t  run_us;                           /* 运行总时间 */
+    uint32_t  run_max_us;                       /* 最长一次运行 */
+
+    uint32_t  wake_count;                       /* 唤醒次数 */
+    uint64_t  wake_us;                          /* 唤醒到运行, 总和 */
+    uint32_t  wake_max_us;
+
+    uint64_t  block_us[PSCHED_BLOCK_TYPES];     /* 阻塞时间 */
+} pesudoos_task_stats_t;
+
+/*
+ * fill at most max tasks, return the count filled
+ */
+int pesudoos_task_stats(pesudoos_task_stats_t *stats, int max);
+
+/*
+ * clear max run and max wakeup latency of pesudo_sched tasks
+ */
+void pesudoos_task_stats_reset_max(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_PROF_H
+
+/*
+ * @@ END
+ */
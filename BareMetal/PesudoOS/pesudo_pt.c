@@ -0,0 +1,84 @@
+/*
+ * pesudo_pt.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "pesudo_pt.h"
+
+//-----------------------------------------------------------------------------
+
+int pesudo_pt_wait(pesudo_pt_t *pt, void *obj, uint32_t timeout_ms)
+{
+    uint64_t now = get_clock_ticks();
+    uint32_t remain = timeout_ms;
+    int rt;
+
+    if (timeout_ms == 0)
+    {
+        return OSAL_ERR_TIMEOUT;
+    }
+
+    if (pt->waiting)
+    {
+        /*
+         * 被唤醒后对象又被别的任务取走, 在剩余时间内继续等待
+         */
+        rt = psched_wait_result();
+        if ((rt == PSCHED_WAIT_TIMEOUT) || (rt == PSCHED_WAIT_DELETED))
+        {
+            pt->waiting = 0;
+            return OSAL_ERR_TIMEOUT;
+        }
+
+        if (timeout_ms != OSAL_WAIT_FOREVER)
+        {
+            if ((int64_t)(pt->until - now) <= 0)
+            {
+                pt->waiting = 0;
+                return OSAL_ERR_TIMEOUT;
+            }
+
+            remain = (uint32_t)(pt->until - now);
+        }
+    }
+    else
+    {
+        pt->waiting = 1;
+        pt->until   = now + timeout_ms;
+    }
+
+    /*
+     * 返回对象序号时已经就绪, 任务返回后下一遍再取
+     */
+    if (psched_wait_any(&obj, 1, remain) == PSCHED_WAIT_INVAL)
+    {
+        pt->waiting = 0;
+        return OSAL_ERR_INVAL;
+    }
+
+    return PESUDO_PT_WAIT;
+}
+
+void pesudo_pt_exit(void)
+{
+    psched_task_delete(psched_current());
+}
+
+psched_task_t *pesudo_pt_create(const char *name, uint32_t prio,
+                                pesudo_task_entry_t entry, pesudo_pt_t *pt)
+{
+    if (!pt)
+    {
+        return NULL;
+    }
+
+    pt_init(pt);
+
+    return psched_task_create(name, prio, entry, pt);
+}
+
+/*
+ * @@ END
+ */
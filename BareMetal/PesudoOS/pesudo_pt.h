@@ -0,0 +1,229 @@
+/*
+ * pesudo_pt.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Stackless task (protothread).
+ *
+ * A task of pesudo_sched without stack runs on the stack of the main loop,
+ * but it can't wait in the middle of the entry. A protothread records where
+ * it waits in pt->lc, returns, and continues there when it runs again:
+ *
+ *     typedef struct sensor
+ *     {
+ *         pesudo_pt_t pt;                     // first member
+ *         int         count;                  // state between awaits
+ *     } sensor_t;
+ *
+ *     static void sensor_thread(void *arg)
+ *     {
+ *         sensor_t *s = (sensor_t *)arg;
+ *         int rt;
+ *
+ *         pt_begin(&s->pt);
+ *         for (;;)
+ *         {
+ *             await_mq(&s->pt, mq, &msg, sizeof(msg), 100, rt);
+ *             if (rt == OSAL_ERR_OK)
+ *                 s->count++;
+ *             await_sleep(&s->pt, 10);
+ *         }
+ *         pt_end(&s->pt);
+ *     }
+ *
+ *     pesudo_pt_create("sensor", prio, sensor_thread, &m_sensor);
+ *
+ * The objects are of pesudo_waitq.h. Local variables are lost at an await,
+ * keep the state in the struct. switch() can't have an await inside.
+ *
+ * An await checks the object first: a handle of libbsp, of another type or
+ * deleted is not touched, rt is OSAL_ERR_INVAL (got is 0 of await_event).
+ *
+ * The memory of a task is the psched_task_t and the struct of the user.
+ */
+
+#ifndef _PESUDO_PT_H
+#define _PESUDO_PT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "osal.h"
+#include "pesudo_sched.h"
+#include "pesudo_waitq.h"
+#include "pesudo_topic.h"
+
+//-----------------------------------------------------------------------------
+
+typedef struct pesudo_pt
+{
+    uint32_t  lc;                               /* 继续执行的位置, 0: 开始 */
+    uint32_t  waiting;                          /* 正在等待对象 */
+    uint64_t  until;                            /* 等待超时 ticks */
+} pesudo_pt_t;
+
+#define PESUDO_PT_WAIT          (-1)            /* 已开始等待, 任务返回 */
+
+/*
+ * psched 对象并且是这种类型, 不是 libbsp 的句柄
+ */
+#define pt_obj_is(obj, t)                                                   \
+    (psched_obj_valid(obj) && (((psched_obj_t *)(obj))->type == (t)))
+
+#define pt_init(pt)                                                         \
+    do { (pt)->lc = 0; (pt)->waiting = 0; } while (0)
+
+#define pt_begin(pt)                                                        \
+    switch ((pt)->lc) { case 0:
+
+/*
+ * the thread is done, the task is deleted
+ */
+#define pt_end(pt)                                                          \
+    } pt_init(pt); pesudo_pt_exit(); return
+
+/*
+ * end the thread here
+ */
+#define pt_exit(pt)                                                         \
+    do { pt_init(pt); pesudo_pt_exit(); return; } while (0)
+
+/*
+ * run again after the other ready tasks
+ */
+#define pt_yield(pt)                                                        \
+    do { (pt)->lc = __LINE__; return; case __LINE__:; } while (0)
+
+#define await_sleep(pt, ms)                                                 \
+    do {                                                                    \
+        (pt)->lc = __LINE__;                                                \
+        psched_task_sleep(ms);                                              \
+        return;                                                             \
+        case __LINE__:;                                                     \
+    } while (0)
+
+/*
+ * check cond every pass
+ */
+#define await_until(pt, cond)                                               \
+    do {                                                                    \
+        (pt)->lc = __LINE__; case __LINE__:                                 \
+        if (!(cond))                                                        \
+            return;                                                         \
+    } while (0)
+
+/*
+ * rt: OSAL_ERR_OK, OSAL_ERR_TIMEOUT, OSAL_ERR_INVAL
+ */
+#define await_sem(pt, sem, timeout, rt)                                     \
+    do {                                                                    \
+        (pt)->lc = __LINE__; case __LINE__:                                 \
+        if (!pt_obj_is(sem, PSCHED_OBJ_SEM))                                \
+            (rt) = OSAL_ERR_INVAL;                                          \
+        else if (((rt) = psched_sem_obtain(sem)) != OSAL_ERR_OK)            \
+        {                                                                   \
+            if (((rt) = pesudo_pt_wait(pt, sem, timeout)) == PESUDO_PT_WAIT) \
+                return;                                                     \
+        }                                                                   \
+        (pt)->waiting = 0;                                                  \
+    } while (0)
+
+/*
+ * got: the received bits, 0 if timeout
+ */
+#define await_event(pt, event, bits, flag, timeout, got)                    \
+    do {                                                                    \
+        (pt)->lc = __LINE__; case __LINE__:                                 \
+        if (!pt_obj_is(event, PSCHED_OBJ_EVENT))                            \
+            (got) = 0;                                                      \
+        else if (((got) = psched_event_receive(event, bits, flag)) == 0)    \
+        {                                                                   \
+            if (pesudo_pt_wait(pt, event, timeout) == PESUDO_PT_WAIT)       \
+                return;                                                     \
+        }                                                                   \
+        (pt)->waiting = 0;                                                  \
+    } while (0)
+
+/*
+ * rt: OSAL_ERR_OK, OSAL_ERR_TIMEOUT, OSAL_ERR_INVAL
+ */
+#define await_mq(pt, mq, msg, size, timeout, rt)                            \
+    do {                                                                    \
+        (pt)->lc = __LINE__; case __LINE__:                                 \
+        if (!psched_mq_valid(mq))                                           \
+            (rt) = OSAL_ERR_INVAL;                                          \
+        else if (((rt) = psched_mq_receive(mq, msg, size)) == OSAL_ERR_TIMEOUT) \
+        {                                                                   \
+            if (((rt) = pesudo_pt_wait(pt, mq, timeout)) == PESUDO_PT_WAIT) \
+                return;                                                     \
+        }                                                                   \
+        (pt)->waiting = 0;                                                  \
+    } while (0)
+
+/*
+ * ptr: the message in its slot, psched_mq_release() it after use
+ */
+#define await_mq_ref(pt, mq, ptr, timeout, rt)                              \
+    do {                                                                    \
+        (pt)->lc = __LINE__; case __LINE__:                                 \
+        if (!psched_mq_valid(mq))                                           \
+            (rt) = OSAL_ERR_INVAL;                                          \
+        else if (((rt) = psched_mq_receive_ref(mq, ptr)) == OSAL_ERR_TIMEOUT) \
+        {                                                                   \
+            if (((rt) = pesudo_pt_wait(pt, mq, timeout)) == PESUDO_PT_WAIT) \
+                return;                                                     \
+        }                                                                   \
+        (pt)->waiting = 0;                                                  \
+    } while (0)
+
+/*
+ * pdata: the payload of pesudo_topic.h, topic_release() it after use
+ */
+#define await_topic(pt, sub, pdata, timeout, rt)                            \
+    do {                                                                    \
+        (pt)->lc = __LINE__; case __LINE__:                                 \
+        if (!topic_sub_valid(sub))                                          \
+            (rt) = OSAL_ERR_INVAL;                                          \
+        else if (((rt) = topic_receive(sub, pdata)) == OSAL_ERR_TIMEOUT)    \
+        {                                                                   \
+            if (((rt) = pesudo_pt_wait(pt, sub, timeout)) == PESUDO_PT_WAIT) \
+                return;                                                     \
+        }                                                                   \
+        (pt)->waiting = 0;                                                  \
+    } while (0)
+
+//-----------------------------------------------------------------------------
+
+/*
+ * wait the object in the rest of timeout, return PESUDO_PT_WAIT, or
+ * OSAL_ERR_TIMEOUT when it's over
+ */
+int pesudo_pt_wait(pesudo_pt_t *pt, void *obj, uint32_t timeout_ms);
+
+/*
+ * delete current task
+ */
+void pesudo_pt_exit(void);
+
+/*
+ * a task of pesudo_sched without stack, arg is the pesudo_pt_t or the struct
+ * it is the first member
+ */
+psched_task_t *pesudo_pt_create(const char *name, uint32_t prio,
+                                pesudo_task_entry_t entry, pesudo_pt_t *pt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_PT_H
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,1424 @@
+/*
+ * pesudo_sched.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "osal.h"
+#include "memory_man.h"
+#include "pesudo_sched.h"
+#include "pesudo_defer.h"
+#include "pesudo_stack.h"
+#include "pesudo_task_ext.h"
+#include "stable_counter.h"
+
+extern int fls(int x);
+
+//-----------------------------------------------------------------------------
+
+TAILQ_HEAD(psched_queue, psched_task);
+
+/*
+ * 就绪队列: 每个优先级一个 FIFO 队列, bitmap 的 bit (31 - prio) 表示队列不空,
+ * 最高优先级 = 32 - fls(bitmap).
+ *
+ * 一遍调度中任务运行后进入 expired 队列, active 队列空后本遍结束, 交换两者.
+ * 这样高优先级任务不会在一遍中反复运行, 低优先级任务每遍都能运行一次.
+ */
+typedef struct psched_ready
+{
+    uint32_t            bitmap;
+    struct psched_queue queue[PSCHED_PRIO_MAX];
+} psched_ready_t;
+
+static psched_ready_t  m_ready[2];
+static psched_ready_t *m_active  = &m_ready[0];
+static psched_ready_t *m_expired = &m_ready[1];
+
+static struct psched_queue m_task_list = TAILQ_HEAD_INITIALIZER(m_task_list);
+
+/*
+ * 周期任务, 每遍检查是否到了释放时间
+ */
+static TAILQ_HEAD(psched_period_list, psched_period) m_period_list =
+    TAILQ_HEAD_INITIALIZER(m_period_list);
+
+/*
+ * 休眠任务和定时器
+ */
+static pwheel_t m_wheel;
+
+static psched_task_t *m_current = NULL;
+static int m_initialized = 0;
+
+static pesudo_ctx_t m_sched_ctx;        /* 切换到有堆栈的任务时保存 */
+
+static size_t m_flag;                   /* pesudo_sched_run() 的临界区 */
+
+static osal_pool_t m_obj_pool = NULL;   /* 对象的内存 */
+
+//-----------------------------------------------------------------------------
+
+#define PRIO_BIT(prio)      (0x80000000u >> (prio))
+
+static void psched_init(void)
+{
+    int i;
+
+    for (i=0; i<PSCHED_PRIO_MAX; i++)
+    {
+        TAILQ_INIT(&m_ready[0].queue[i]);
+        TAILQ_INIT(&m_ready[1].queue[i]);
+    }
+
+    m_ready[0].bitmap = 0;
+    m_ready[1].bitmap = 0;
+
+    pwheel_init(&m_wheel, get_clock_ticks());
+
+    m_initialized = 1;
+}
+
+static inline void ready_insert(psched_ready_t *rdy, psched_task_t *task)
+{
+    TAILQ_INSERT_TAIL(&rdy->queue[task->prio], task, node);
+    rdy->bitmap |= PRIO_BIT(task->prio);
+    task->ready = rdy;
+}
+
+static inline void ready_remove(psched_ready_t *rdy, psched_task_t *task)
+{
+    TAILQ_REMOVE(&rdy->queue[task->prio], task, node);
+    if (TAILQ_EMPTY(&rdy->queue[task->prio]))
+    {
+        rdy->bitmap &= ~PRIO_BIT(task->prio);
+    }
+}
+
+static inline psched_task_t *ready_pop_highest(psched_ready_t *rdy)
+{
+    psched_task_t *task;
+
+    if (rdy->bitmap == 0)
+    {
+        return NULL;
+    }
+
+    task = TAILQ_FIRST(&rdy->queue[32 - fls((int)rdy->bitmap)]);
+    ready_remove(rdy, task);
+
+    return task;
+}
+
+/*
+ * 从等待的对象中移出
+ */
+static void task_unlink_waiters(psched_task_t *task)
+{
+    psched_waiter_t *w;
+    uint32_t i;
+
+    for (i=0; i<task->wait_count; i++)
+    {
+        w = &task->waiter[i];
+        if (w->obj)
+        {
+            TAILQ_REMOVE(&w->obj->waitq, w, node);
+            w->obj = NULL;
+        }
+    }
+
+    task->wait_count = 0;
+}
+
+/*
+ * 从所在的就绪队列, 时间轮或等待对象中移出
+ */
+static void task_unlink(psched_task_t *task)
+{
+    if (task->state & PS_STATE_READY)
+    {
+        ready_remove((psched_ready_t *)task->ready, task);
+    }
+    else if (task->state & (PS_STATE_SLEEP | PS_STATE_WAIT))
+    {
+        pwheel_del(&m_wheel, &task->wake_timer);
+
+        if (task->state & PS_STATE_WAIT)
+        {
+            /*
+             * 运行中的任务返回后才加入等待队列
+             */
+            if (task->state & PS_STATE_RUNNING)
+                task->wait_count = 0;
+            else
+                task_unlink_waiters(task);
+        }
+    }
+
+    task->state &= ~(PS_STATE_READY | PS_STATE_SLEEP | PS_STATE_WAIT | PS_STATE_PERIOD);
+}
+
+/*
+ * 阻塞结束, 累计阻塞时间, 记录唤醒时刻
+ */
+static inline void prof_wake(psched_task_t *task)
+{
+    uint64_t now = stable_counter_read();
+
+    if (task->prof.block_at)
+    {
+        task->prof.block_time[task->prof.block_type] += now - task->prof.block_at;
+        task->prof.block_at = 0;
+    }
+
+    task->prof.ready_at = now;
+}
+
+static inline void prof_block(psched_task_t *task, uint32_t type)
+{
+    task->prof.block_at   = stable_counter_read();
+    task->prof.block_type = type;
+}
+
+/*
+ * 一次运行的统计
+ */
+static inline void prof_run(psched_task_t *task, uint64_t start, uint64_t end)
+{
+    psched_prof_t *prof = &task->prof;
+
+    prof->run_time += end - start;
+    if (end - start > prof->run_max)
+    {
+        prof->run_max = end - start;
+    }
+
+    if (prof->ready_at)
+    {
+        prof->wake_time += start - prof->ready_at;
+        if (start - prof->ready_at > prof->wake_max)
+        {
+            prof->wake_max = start - prof->ready_at;
+        }
+
+        prof->wake_count++;
+        prof->ready_at = 0;
+    }
+}
+
+static inline void task_make_ready(psched_task_t *task)
+{
+    prof_wake(task);
+
+    task->state |= PS_STATE_READY;
+    ready_insert(m_active, task);
+}
+
+/*
+ * 休眠或等待到期
+ */
+static void task_wake_timeout(pwheel_timer_t *timer, void *arg)
+{
+    psched_task_t *task = (psched_task_t *)arg;
+
+    if (task->state & PS_STATE_WAIT)
+    {
+        task_unlink_waiters(task);
+        task->wait_result = PSCHED_WAIT_TIMEOUT;
+    }
+
+    task->state &= ~(PS_STATE_SLEEP | PS_STATE_WAIT);
+    task_make_ready(task);
+}
+
+static void task_free(psched_task_t *task)
+{
+    TAILQ_REMOVE(&m_task_list, task, list);
+
+    if (task->period)
+    {
+        TAILQ_REMOVE(&m_period_list, task->period, node);
+        free(task->period);
+    }
+
+    if (task->stack)
+    {
+        free(task->stack);
+    }
+
+    if (task->arena)
+    {
+        pesudo_arena_free(task->arena);
+        free(task->arena);
+    }
+
+    free(task);
+}
+
+/*
+ * 有堆栈的任务切换回 pesudo_sched_run()
+ */
+static inline void task_switch_out(psched_task_t *task)
+{
+    pesudo_ctx_switch(&task->ctx, &m_sched_ctx);
+}
+
+/*
+ * 栈底保护区被破坏, 挂起不再运行
+ */
+static void task_stack_overflow(psched_task_t *task)
+{
+    task->flags |= PS_FLAG_STACK_OV;
+    task->state |= PS_STATE_SUSPEND;
+
+    LOG_ERR("task %s stack overflow, size %u\r\n", task->name, (unsigned)task->stack_size);
+}
+
+/*
+ * 有堆栈的任务入口返回
+ */
+void pesudo_ctx_exit(void)
+{
+    psched_task_t *task = m_current;
+
+    task->state |= PS_STATE_DELETE;
+    task_switch_out(task);
+}
+
+//-----------------------------------------------------------------------------
+
+psched_task_t *psched_task_create(const char *name,
+                                  uint32_t prio,
+                                  pesudo_task_entry_t entry,
+                                  void *arg)
+{
+    return psched_task_create_stack(name, prio, 0, entry, arg);
+}
+
+psched_task_t *psched_task_create_stack(const char *name,
+                                        uint32_t prio,
+                                        uint32_t stack_size,
+                                        pesudo_task_entry_t entry,
+                                        void *arg)
+{
+    psched_task_t *task;
+    size_t flag;
+
+    if (!entry || (prio >= PSCHED_PRIO_MAX))
+    {
+        return NULL;
+    }
+
+    task = (psched_task_t *)calloc(1, sizeof(psched_task_t));
+    if (!task)
+    {
+        return NULL;
+    }
+
+    if (stack_size)
+    {
+        task->stack = malloc(stack_size);
+        if (!task->stack)
+        {
+            free(task);
+            return NULL;
+        }
+
+        task->stack_size = stack_size;
+        task->flags |= PS_FLAG_STACK;
+        pesudo_stack_paint(task->stack, stack_size);
+        pesudo_ctx_init(&task->ctx, task->stack, stack_size, entry, arg);
+    }
+
+    if (name)
+    {
+        strncpy(task->name, name, PESUDO_NAME_MAX - 1);
+    }
+
+    task->entry    = entry;
+    task->arg      = arg;
+    task->prio     = prio;
+    task->heap_tag = HEAP_TAG_APP;
+
+    task->wait_result = PSCHED_WAIT_NONE;
+
+    pwheel_timer_init(&task->wake_timer, task_wake_timeout, task);
+
+    flag = osal_enter_critical_section();
+
+    if (!m_initialized)
+    {
+        psched_init();
+    }
+
+    TAILQ_INSERT_TAIL(&m_task_list, task, list);
+    task_make_ready(task);
+
+    osal_leave_critical_section(flag);
+
+    return task;
+}
+
+psched_task_t *psched_task_create_once(const char *name,
+                                       uint32_t prio,
+                                       pesudo_task_entry_t entry,
+                                       void *arg)
+{
+    psched_task_t *task;
+    size_t flag;
+
+    task = psched_task_create(name, prio, entry, arg);
+    if (task)
+    {
+        flag = osal_enter_critical_section();
+        task->flags |= PS_FLAG_ONCE;
+        osal_leave_critical_section(flag);
+    }
+
+    return task;
+}
+
+void psched_task_delete(psched_task_t *task)
+{
+    size_t flag;
+
+    if (!task)
+    {
+        return;
+    }
+
+    flag = osal_enter_critical_section();
+
+    task_unlink(task);
+
+    /*
+     * 运行中的任务在返回后删除
+     */
+    if (task->state & PS_STATE_RUNNING)
+    {
+        task->state |= PS_STATE_DELETE;
+    }
+    else
+    {
+        task_free(task);
+    }
+
+    osal_leave_critical_section(flag);
+}
+
+void psched_task_suspend(psched_task_t *task)
+{
+    size_t flag;
+
+    if (!task)
+    {
+        return;
+    }
+
+    flag = osal_enter_critical_section();
+
+    task_unlink(task);
+    task->state |= PS_STATE_SUSPEND;
+    task->prof.block_at = 0;                /* 挂起不计入阻塞时间 */
+
+    osal_leave_critical_section(flag);
+}
+
+void psched_task_resume(psched_task_t *task)
+{
+    size_t flag;
+
+    if (!task)
+    {
+        return;
+    }
+
+    /*
+     * 堆栈溢出的任务不能再运行
+     */
+    if (task->flags & PS_FLAG_STACK_OV)
+    {
+        return;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (task->state & PS_STATE_SUSPEND)
+    {
+        task->state &= ~PS_STATE_SUSPEND;
+
+        /*
+         * 运行中的任务在返回后进入就绪队列, 周期任务等待下次释放
+         */
+        if (task->state & PS_STATE_RUNNING)
+        {
+            /* psched_task_done() */
+        }
+        else if (task->flags & PS_FLAG_PERIODIC)
+        {
+            task->state |= PS_STATE_PERIOD;
+        }
+        else
+        {
+            task_make_ready(task);
+        }
+    }
+
+    osal_leave_critical_section(flag);
+}
+
+void psched_task_sleep(uint32_t ms)
+{
+    psched_task_t *task = m_current;
+
+    if (!task || (ms == 0))
+    {
+        return;
+    }
+
+    /*
+     * 返回后加入时间轮
+     */
+    task->wake_tick = get_clock_ticks() + ms;
+    task->state |= PS_STATE_SLEEP;
+
+    if (task->flags & PS_FLAG_STACK)
+    {
+        task_switch_out(task);
+    }
+}
+
+void psched_task_yield(void)
+{
+    psched_task_t *task = m_current;
+
+    if (task && (task->flags & PS_FLAG_STACK))
+    {
+        task_switch_out(task);
+    }
+}
+
+void psched_task_wakeup(psched_task_t *task)
+{
+    size_t flag;
+
+    if (!task)
+    {
+        return;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (task->state & PS_STATE_SLEEP)
+    {
+        if (task->state & PS_STATE_RUNNING)
+        {
+            task->state &= ~PS_STATE_SLEEP;
+        }
+        else
+        {
+            task_unlink(task);
+            task_make_ready(task);
+        }
+    }
+
+    osal_leave_critical_section(flag);
+}
+
+psched_task_t *psched_current(void)
+{
+    return m_current;
+}
+
+int psched_task_arena_create(psched_task_t *task, size_t size)
+{
+    pesudo_arena_t *arena;
+
+    if (!task || task->arena)
+    {
+        return -1;
+    }
+
+    arena = (pesudo_arena_t *)malloc(sizeof(pesudo_arena_t));
+    if (!arena)
+    {
+        return -1;
+    }
+
+    if (pesudo_arena_init(arena, size) != 0)
+    {
+        free(arena);
+        return -1;
+    }
+
+    task->arena = arena;
+
+    return 0;
+}
+
+void *psched_task_arena_alloc(size_t size)
+{
+    return m_current ? pesudo_arena_alloc(m_current->arena, size) : NULL;
+}
+
+void psched_task_arena_reset(void)
+{
+    if (m_current)
+    {
+        pesudo_arena_reset(m_current->arena);
+    }
+}
+
+int psched_check_blocking(const char *func)
+{
+    psched_task_t *task = m_current;
+
+    /*
+     * libbsp 任务和有堆栈的任务可以阻塞
+     */
+    if (!task || (task->flags & PS_FLAG_STACK))
+    {
+        return 0;
+    }
+
+    if (!(task->flags & PS_FLAG_BLOCK_ERR))
+    {
+        task->flags |= PS_FLAG_BLOCK_ERR;
+        LOG_ERR("task %s has no stack, %s() must not block\r\n",
+                task->name, func ? func : "?");
+    }
+
+    return 1;
+}
+
+psched_task_t *psched_task_list_first(void)
+{
+    return TAILQ_FIRST(&m_task_list);
+}
+
+psched_task_t *psched_task_list_next(psched_task_t *task)
+{
+    return task ? TAILQ_NEXT(task, list) : NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Wait
+//-----------------------------------------------------------------------------
+
+void psched_obj_init(psched_obj_t *obj, uint32_t type, const char *name,
+                     uint32_t opt, int (*is_ready)(psched_obj_t *obj))
+{
+    memset(obj, 0, sizeof(psched_obj_t));
+
+    if (name)
+    {
+        strncpy(obj->name, name, PESUDO_NAME_MAX - 1);
+    }
+
+    obj->magic    = PSCHED_OBJ_MAGIC;
+    obj->type     = type;
+    obj->opt      = opt ? opt : OSAL_OPT_FIFO;
+    obj->is_ready = is_ready;
+    TAILQ_INIT(&obj->waitq);
+}
+
+/*
+ * 按 opt 加入对象的等待队列
+ */
+static void waitq_insert(psched_obj_t *obj, psched_waiter_t *w)
+{
+    psched_waiter_t *p;
+
+    if (obj->opt & OSAL_OPT_PRIO)
+    {
+        TAILQ_FOREACH(p, &obj->waitq, node)
+        {
+            if (p->task->prio > w->task->prio)
+            {
+                TAILQ_INSERT_BEFORE(p, w, node);
+                return;
+            }
+        }
+    }
+    else if (obj->opt & OSAL_OPT_LIFO)
+    {
+        TAILQ_INSERT_HEAD(&obj->waitq, w, node);
+        return;
+    }
+
+    TAILQ_INSERT_TAIL(&obj->waitq, w, node);
+}
+
+static inline int waiter_ready(psched_waiter_t *w)
+{
+    if (w->level)
+    {
+        return w->obj->level(w->obj) >= w->level;
+    }
+
+    return w->obj->is_ready(w->obj);
+}
+
+/*
+ * 任务返回后开始等待. 返回 0: 已有对象就绪, 任务进入就绪队列
+ */
+static int task_wait_arm(psched_task_t *task)
+{
+    psched_waiter_t *w;
+    uint32_t i, count = task->wait_count;
+
+    /*
+     * 调用 psched_wait_any() 之后对象可能已经就绪
+     */
+    for (i=0; i<count; i++)
+    {
+        w = &task->waiter[i];
+        if (waiter_ready(w))
+        {
+            task->state &= ~PS_STATE_WAIT;
+            task->wait_count  = 0;
+            task->wait_result = (int)i;
+            return 0;
+        }
+    }
+
+    for (i=0; i<count; i++)
+    {
+        waitq_insert(task->waiter[i].obj, &task->waiter[i]);
+    }
+
+    prof_block(task, task->waiter[0].obj->type);
+
+    if (task->wait_timeout != OSAL_WAIT_FOREVER)
+    {
+        pwheel_add(&m_wheel, &task->wake_timer, get_clock_ticks() + task->wait_timeout);
+    }
+
+    return 1;
+}
+
+static int task_wait(void *objs[], int n, uint32_t level, uint32_t timeout_ms)
+{
+    psched_task_t *task = m_current;
+    psched_obj_t *obj;
+    size_t flag;
+    int i;
+
+    if (!task || !objs || (n <= 0) || (n > PSCHED_WAIT_MAX))
+    {
+        return PSCHED_WAIT_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    for (i=0; i<n; i++)
+    {
+        /*
+         * libbsp 的对象没有 magic, 不能调用它的 is_ready()
+         */
+        obj = (psched_obj_t *)objs[i];
+        if (!psched_obj_valid(obj) || !obj->is_ready || (level && !obj->level))
+        {
+            osal_leave_critical_section(flag);
+            return PSCHED_WAIT_INVAL;
+        }
+
+        /*
+         * 返回后加入等待队列
+         */
+        task->waiter[i].task  = task;
+        task->waiter[i].obj   = obj;
+        task->waiter[i].level = level;
+
+        if (waiter_ready(&task->waiter[i]))
+        {
+            osal_leave_critical_section(flag);
+            return i;
+        }
+    }
+
+    if (timeout_ms == 0)
+    {
+        osal_leave_critical_section(flag);
+        return PSCHED_WAIT_TIMEOUT;
+    }
+
+    task->wait_count   = n;
+    task->wait_timeout = timeout_ms;
+    task->state |= PS_STATE_WAIT;
+
+    osal_leave_critical_section(flag);
+
+    if (task->flags & PS_FLAG_STACK)
+    {
+        task_switch_out(task);
+        return task->wait_result;
+    }
+
+    return PSCHED_WAIT_NONE;
+}
+
+int psched_wait_any(void *objs[], int n, uint32_t timeout_ms)
+{
+    return task_wait(objs, n, 0, timeout_ms);
+}
+
+int psched_wait_level(void *obj, uint32_t level, uint32_t timeout_ms)
+{
+    void *objs[1] = { obj };
+
+    return task_wait(objs, 1, level, timeout_ms);
+}
+
+int psched_wait_result(void)
+{
+    return m_current ? m_current->wait_result : PSCHED_WAIT_NONE;
+}
+
+/*
+ * 等待结束, 任务进入就绪队列
+ */
+static void task_wait_done(psched_task_t *task, int result)
+{
+    pwheel_del(&m_wheel, &task->wake_timer);
+    task_unlink_waiters(task);
+
+    task->state &= ~PS_STATE_WAIT;
+    task->wait_result = result;
+    task_make_ready(task);
+}
+
+int psched_obj_wake(psched_obj_t *obj, int count)
+{
+    psched_waiter_t *w, *next;
+    int waked = 0;
+
+    if (obj->opt & OSAL_OPT_ALL)
+    {
+        count = -1;
+    }
+
+    for (w = TAILQ_FIRST(&obj->waitq); w && ((count < 0) || (waked < count)); w = next)
+    {
+        next = TAILQ_NEXT(w, node);
+
+        /*
+         * psched_wait_level() 的等待者数量不够时留在队列中
+         */
+        if (w->level && !waiter_ready(w))
+        {
+            continue;
+        }
+
+        task_wait_done(w->task, (int)(w - w->task->waiter));
+        waked++;
+    }
+
+    return waked;
+}
+
+void psched_obj_cleanup(psched_obj_t *obj)
+{
+    psched_waiter_t *w;
+    size_t flag;
+
+    flag = osal_enter_critical_section();
+
+    while ((w = TAILQ_FIRST(&obj->waitq)) != NULL)
+    {
+        task_wait_done(w->task, PSCHED_WAIT_DELETED);
+    }
+
+    obj->magic = 0;
+
+    osal_leave_critical_section(flag);
+}
+
+void *psched_obj_alloc(size_t size)
+{
+    void *ptr = NULL;
+
+    /*
+     * 第一次创建对象时创建, 对象在主循环中创建
+     */
+    if (!m_obj_pool)
+    {
+        m_obj_pool = osal_pool_create("psched_obj", PSCHED_OBJ_POOL_SIZE, PSCHED_OBJ_POOL_COUNT);
+    }
+
+    if (size <= PSCHED_OBJ_POOL_SIZE)
+    {
+        ptr = osal_pool_alloc(m_obj_pool);
+    }
+
+    return ptr ? ptr : malloc(size);
+}
+
+void psched_obj_free(void *ptr)
+{
+    /*
+     * 不在池中的是 malloc() 的
+     */
+    if (ptr && (osal_pool_free(m_obj_pool, ptr) != OSAL_ERR_OK))
+    {
+        free(ptr);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Timer
+//-----------------------------------------------------------------------------
+
+static void timer_timeout(pwheel_timer_t *timer, void *arg)
+{
+    psched_timer_t *tmr = (psched_timer_t *)arg;
+
+    /*
+     * 周期定时器按上次到期时间累加, 不累积误差; 落后太多时不补
+     */
+    if (tmr->is_period)
+    {
+        uint64_t now  = get_clock_ticks();
+        uint64_t next = timer->expires + tmr->timeout_ms;
+
+        if ((int64_t)(next - now) <= 0)
+        {
+            next = now + tmr->timeout_ms;
+        }
+
+        pwheel_add(&m_wheel, timer, next);
+    }
+
+    /*
+     * 在临界区外回调
+     */
+    osal_leave_critical_section(m_flag);
+    tmr->callback(tmr->arg);
+    m_flag = osal_enter_critical_section();
+}
+
+psched_timer_t *psched_timer_create(const char *name,
+                                    pesudo_task_entry_t entry,
+                                    void *argument,
+                                    uint32_t timeout_ms,
+                                    bool is_period)
+{
+    psched_timer_t *tmr;
+    size_t flag;
+
+    if (!entry)
+    {
+        return NULL;
+    }
+
+    tmr = (psched_timer_t *)calloc(1, sizeof(psched_timer_t));
+    if (!tmr)
+    {
+        return NULL;
+    }
+
+    if (name)
+    {
+        strncpy(tmr->name, name, PESUDO_NAME_MAX - 1);
+    }
+
+    tmr->callback   = entry;
+    tmr->arg        = argument;
+    tmr->timeout_ms = timeout_ms < PSCHED_TIMER_MS_MIN ? PSCHED_TIMER_MS_MIN : timeout_ms;
+    tmr->is_period  = is_period ? 1 : 0;
+
+    pwheel_timer_init(&tmr->wt, timer_timeout, tmr);
+
+    flag = osal_enter_critical_section();
+    if (!m_initialized)
+    {
+        psched_init();
+    }
+    osal_leave_critical_section(flag);
+
+    return tmr;
+}
+
+void psched_timer_delete(psched_timer_t *tmr)
+{
+    if (tmr)
+    {
+        psched_timer_stop(tmr);
+        free(tmr);
+    }
+}
+
+int psched_timer_start(psched_timer_t *tmr, uint32_t timeout_ms)
+{
+    size_t flag;
+
+    if (!tmr)
+    {
+        return -1;
+    }
+
+    if (timeout_ms != 0)
+    {
+        tmr->timeout_ms = timeout_ms < PSCHED_TIMER_MS_MIN ? PSCHED_TIMER_MS_MIN : timeout_ms;
+    }
+
+    flag = osal_enter_critical_section();
+    pwheel_add(&m_wheel, &tmr->wt, get_clock_ticks() + tmr->timeout_ms);
+    osal_leave_critical_section(flag);
+
+    return 0;
+}
+
+int psched_timer_stop(psched_timer_t *tmr)
+{
+    size_t flag;
+
+    if (!tmr)
+    {
+        return -1;
+    }
+
+    flag = osal_enter_critical_section();
+    pwheel_del(&m_wheel, &tmr->wt);
+    osal_leave_critical_section(flag);
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Periodic
+//-----------------------------------------------------------------------------
+
+uint32_t psched_rm_prio(uint32_t period_us)
+{
+    uint32_t prio;
+
+    /*
+     * 1ms: 1, 2~3ms: 2, 4~7ms: 3, 10ms: 4, 50ms: 6, 100ms: 7 ...
+     */
+    prio = (uint32_t)fls((int)(period_us / 1000));
+
+    return prio > PSCHED_PRIO_LOWEST ? PSCHED_PRIO_LOWEST : prio;
+}
+
+psched_task_t *psched_task_create_periodic(const char *name,
+                                           uint32_t prio,
+                                           uint32_t period_us,
+                                           uint32_t deadline_us,
+                                           pesudo_task_entry_t entry,
+                                           void *arg)
+{
+    psched_period_t *per;
+    psched_task_t *task;
+    size_t flag;
+
+    if (period_us == 0)
+    {
+        return NULL;
+    }
+
+    per = (psched_period_t *)calloc(1, sizeof(psched_period_t));
+    if (!per)
+    {
+        return NULL;
+    }
+
+    if ((deadline_us == 0) || (deadline_us > period_us))
+    {
+        deadline_us = period_us;
+    }
+
+    per->period   = stable_counter_from_us(period_us);
+    per->deadline = stable_counter_from_us(deadline_us);
+    per->stats.period_us   = period_us;
+    per->stats.deadline_us = deadline_us;
+
+    if (per->period == 0)
+    {
+        per->period = 1;
+    }
+
+    task = psched_task_create(name, prio, entry, arg);
+    if (!task)
+    {
+        free(per);
+        return NULL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    /*
+     * 创建时已就绪, 改为等待第一次释放
+     */
+    task_unlink(task);
+
+    per->task = task;
+    per->next_release = stable_counter_read();
+
+    task->period = per;
+    task->flags |= PS_FLAG_PERIODIC;
+    task->state |= PS_STATE_PERIOD;
+
+    TAILQ_INSERT_TAIL(&m_period_list, per, node);
+
+    osal_leave_critical_section(flag);
+
+    return task;
+}
+
+void psched_task_set_overrun_hook(psched_task_t *task, psched_overrun_hook_t hook)
+{
+    if (task && task->period)
+    {
+        task->period->overrun = hook;
+    }
+}
+
+int psched_task_period_stats(psched_task_t *task, psched_period_stats_t *stats)
+{
+    size_t flag;
+
+    if (!task || !task->period || !stats)
+    {
+        return -1;
+    }
+
+    flag = osal_enter_critical_section();
+    *stats = task->period->stats;
+    osal_leave_critical_section(flag);
+
+    return 0;
+}
+
+void psched_task_period_stats_reset(psched_task_t *task)
+{
+    psched_period_stats_t *st;
+    size_t flag;
+
+    if (!task || !task->period)
+    {
+        return;
+    }
+
+    st = &task->period->stats;
+
+    flag = osal_enter_critical_section();
+
+    st->releases      = 0;
+    st->misses        = 0;
+    st->skipped       = 0;
+    st->jitter_max_us = 0;
+    st->jitter_sum_us = 0;
+    st->exec_us       = 0;
+    st->exec_max_us   = 0;
+    st->exec_sum_us   = 0;
+    st->late_max_us   = 0;
+
+    osal_leave_critical_section(flag);
+}
+
+/*
+ * 到了释放时间的周期任务进入就绪队列. 释放时间按周期累加, 不累积误差
+ */
+static void period_release(uint64_t now)
+{
+    psched_period_t *per;
+    psched_task_t *task;
+    uint64_t n;
+
+    TAILQ_FOREACH(per, &m_period_list, node)
+    {
+        if ((int64_t)(now - per->next_release) < 0)
+        {
+            continue;
+        }
+
+        task = per->task;
+
+        if (task->state & PS_STATE_SUSPEND)
+        {
+            /* 挂起期间不计 */
+        }
+        else if (task->state & PS_STATE_PERIOD)
+        {
+            task->state &= ~PS_STATE_PERIOD;
+            task_make_ready(task);
+
+            per->release = per->next_release;
+            per->stats.releases++;
+        }
+        else
+        {
+            per->stats.skipped++;
+        }
+
+        per->next_release += per->period;
+
+        /*
+         * 落后一个周期以上, 跳过错过的释放
+         */
+        if ((int64_t)(now - per->next_release) >= 0)
+        {
+            n = (now - per->next_release) / per->period + 1;
+            per->next_release += n * per->period;
+
+            if (!(task->state & PS_STATE_SUSPEND))
+            {
+                per->stats.skipped += (uint32_t)n;
+            }
+        }
+    }
+}
+
+/*
+ * 一次运行的统计, 在临界区外调用
+ */
+static void period_account(psched_task_t *task, uint64_t start, uint64_t end)
+{
+    psched_period_t *per = task->period;
+    psched_period_stats_t *st = &per->stats;
+    uint32_t jitter, exec, late = 0;
+
+    jitter = (uint32_t)stable_counter_to_us(start - per->release);
+    exec   = (uint32_t)stable_counter_to_us(end - start);
+
+    if (jitter > st->jitter_max_us)
+        st->jitter_max_us = jitter;
+    st->jitter_sum_us += jitter;
+
+    st->exec_us = exec;
+    if (exec > st->exec_max_us)
+        st->exec_max_us = exec;
+    st->exec_sum_us += exec;
+
+    if (end - per->release > per->deadline)
+    {
+        late = (uint32_t)stable_counter_to_us(end - per->release - per->deadline);
+
+        st->misses++;
+        if (late > st->late_max_us)
+            st->late_max_us = late;
+
+        if (per->overrun)
+        {
+            per->overrun(task, late);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/*
+ * 任务返回后, 根据状态进入对应的队列
+ */
+static void psched_task_done(psched_task_t *task)
+{
+    task->state &= ~PS_STATE_RUNNING;
+    task->wait_result = PSCHED_WAIT_NONE;
+
+    if ((task->flags & PS_FLAG_ONCE) &&
+        !(task->state & (PS_STATE_SUSPEND | PS_STATE_SLEEP | PS_STATE_WAIT)))
+    {
+        task->state |= PS_STATE_DELETE;
+    }
+
+    if (task->state & PS_STATE_DELETE)
+    {
+        task_free(task);
+    }
+    else if (task->state & PS_STATE_SUSPEND)
+    {
+        task->state &= ~(PS_STATE_SLEEP | PS_STATE_WAIT);
+        task->wait_count = 0;
+    }
+    else if (task->state & PS_STATE_SLEEP)
+    {
+        pwheel_add(&m_wheel, &task->wake_timer, task->wake_tick);
+        prof_block(task, PSCHED_BLOCK_SLEEP);
+    }
+    else if ((task->state & PS_STATE_WAIT) && task_wait_arm(task))
+    {
+        /* 加入对象的等待队列 */
+    }
+    else if (task->flags & PS_FLAG_PERIODIC)
+    {
+        task->state |= PS_STATE_PERIOD;
+        prof_block(task, PSCHED_BLOCK_PERIOD);
+    }
+    else
+    {
+        task->state |= PS_STATE_READY;
+        ready_insert(m_expired, task);
+    }
+}
+
+int pesudo_sched_run(void)
+{
+    psched_ready_t *tmp;
+    psched_task_t *task;
+    uint64_t start, end;
+    unsigned int tag;
+    int count = 0;
+
+    /*
+     * 中断中推迟的操作, libbsp 的对象也在这里处理
+     */
+    pesudo_defer_drain();
+
+    if (!m_initialized)
+    {
+        return 0;
+    }
+
+    m_flag = osal_enter_critical_section();
+
+    pwheel_advance(&m_wheel, get_clock_ticks());
+    period_release(stable_counter_read());
+
+    while ((task = ready_pop_highest(m_active)) != NULL)
+    {
+        task->state &= ~PS_STATE_READY;
+        task->state |= PS_STATE_RUNNING;
+        m_current = task;
+
+        osal_leave_critical_section(m_flag);
+
+        /*
+         * 任务运行期间的内存记在它的 tag 上
+         */
+        tag   = heap_set_tag(task->heap_tag);
+        start = stable_counter_read();
+
+        if (task->flags & PS_FLAG_STACK)
+        {
+            pesudo_ctx_switch(&m_sched_ctx, &task->ctx);
+
+            if (!pesudo_stack_guard_ok(task->stack))
+            {
+                task_stack_overflow(task);
+            }
+        }
+        else
+        {
+            task->entry(task->arg);
+        }
+
+        end = stable_counter_read();
+        heap_set_tag(tag);
+
+        /*
+         * 没有堆栈的任务一次运行是一个处理周期, 工作缓冲区一起释放
+         */
+        if (task->arena && !(task->flags & PS_FLAG_STACK))
+        {
+            pesudo_arena_reset(task->arena);
+        }
+
+        prof_run(task, start, end);
+        if (task->flags & PS_FLAG_PERIODIC)
+        {
+            period_account(task, start, end);
+        }
+
+        task->run_count++;
+        count++;
+
+        m_flag = osal_enter_critical_section();
+
+        m_current = NULL;
+        psched_task_done(task);
+
+        /*
+         * 运行期间到期的高优先级任务, 在本遍中排到前面
+         */
+        pwheel_advance(&m_wheel, get_clock_ticks());
+        period_release(stable_counter_read());
+    }
+
+    /*
+     * 本遍结束, 已运行的任务下一遍再运行
+     */
+    tmp = m_active;
+    m_active  = m_expired;
+    m_expired = tmp;
+
+    osal_leave_critical_section(m_flag);
+
+    return count;
+}
+
+/*
+ * 最早的释放时间换算成 ticks, 向下取整: 提前醒来, 不会晚
+ */
+static void period_next_tick(uint64_t *tick)
+{
+    psched_period_t *per;
+    uint64_t now = stable_counter_read();
+    uint64_t ms  = get_clock_ticks();
+    uint64_t t;
+
+    TAILQ_FOREACH(per, &m_period_list, node)
+    {
+        if (per->task->state & PS_STATE_SUSPEND)
+        {
+            continue;
+        }
+
+        if ((int64_t)(per->next_release - now) <= 0)
+        {
+            *tick = 0;
+            return;
+        }
+
+        t = ms + stable_counter_to_us(per->next_release - now) / 1000;
+        if (t < *tick)
+        {
+            *tick = t;
+        }
+    }
+}
+
+uint64_t pesudo_sched_next_tick(void)
+{
+    uint64_t tick = PSCHED_TICK_NEVER;
+    size_t flag;
+
+    if (pesudo_defer_pending())
+    {
+        return 0;
+    }
+
+    if (!m_initialized)
+    {
+        return tick;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (m_active->bitmap | m_expired->bitmap)
+    {
+        tick = 0;
+    }
+    else if (!pwheel_next_expiry(&m_wheel, &tick))
+    {
+        tick = PSCHED_TICK_NEVER;
+    }
+
+    if (tick && !TAILQ_EMPTY(&m_period_list))
+    {
+        period_next_tick(&tick);
+    }
+
+    osal_leave_critical_section(flag);
+
+    return tick;
+}
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,449 @@
+/*
+ * pesudo_sched.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Priority scheduler of PesudoOS.
+ *
+ * pesudoos_run() of libbsp walk all tasks in list order, every task is equal.
+ * The tasks here have priority: 0 is the highest, PSCHED_PRIO_MAX - 1 is the
+ * lowest. Ready tasks are in FIFO lists per priority, and a bitmap record the
+ * not empty lists, so the next task is found by fls() in O(1).
+ *
+ * A task entry is called once as one cycle, and must return (run to
+ * completion), then the task is ready again unless it sleep, suspend or is
+ * deleted during the cycle. Such tasks have no stack, they all run on the
+ * stack of the main loop, so the memory is for the tasks with stack only.
+ * They must not call a blocking function of OSAL, it is checked in debug
+ * build, see psched_check_blocking().
+ *
+ * A task created by psched_task_create_stack() has its own stack, the entry
+ * is a loop that is called once. psched_task_sleep(), psched_wait_any() and
+ * psched_task_yield() switch out of it at once by pesudo_ctx_switch(), and
+ * return when it is run again. The stack is painted when created, its guard
+ * is checked after every switch out, see pesudo_stack.h.
+ *
+ * The main loop call pesudo_sched_run() before pesudoos_run(0): in a pass
+ * every ready task run once by priority, then the tasks of libbsp run.
+ */
+
+#ifndef _PESUDO_SCHED_H
+#define _PESUDO_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <sys/queue.h>
+
+#include "pesudoos.h"
+#include "pesudo_wheel.h"
+#include "pesudo_ctx.h"
+
+//-----------------------------------------------------------------------------
+
+#define PSCHED_PRIO_MAX         32
+#define PSCHED_PRIO_HIGHEST     0
+#define PSCHED_PRIO_LOWEST      (PSCHED_PRIO_MAX - 1)
+
+/*
+ * task state
+ */
+#define PS_STATE_READY          0x0001          /* 就绪 */
+#define PS_STATE_RUNNING        0x0002          /* 运行 */
+#define PS_STATE_SLEEP          0x0004          /* 休眠 */
+#define PS_STATE_SUSPEND        0x0008          /* 挂起 */
+#define PS_STATE_WAIT           0x0010          /* 等待对象 */
+#define PS_STATE_PERIOD         0x0020          /* 等待下一周期 */
+#define PS_STATE_DELETE         0x0080          /* 本次运行后删除 */
+
+/*
+ * task flags
+ */
+#define PS_FLAG_STACK           0x0001          /* 有自己的堆栈 */
+#define PS_FLAG_PERIODIC        0x0002          /* 周期任务 */
+#define PS_FLAG_STACK_OV        0x0004          /* 堆栈溢出, 已挂起 */
+#define PS_FLAG_ONCE            0x0008          /* 运行一次后删除 */
+#define PS_FLAG_BLOCK_ERR       0x0010          /* 调用过阻塞函数, 已报错 */
+
+/*
+ * profile: time in stable counter, block time by the type the task waits,
+ * 1~3 are PSCHED_OBJ_SEM/EVENT/MQ, the first object of psched_wait_any().
+ */
+#define PSCHED_BLOCK_SLEEP      0
+#define PSCHED_BLOCK_SEM        1
+#define PSCHED_BLOCK_EVENT      2
+#define PSCHED_BLOCK_MQ         3
+#define PSCHED_BLOCK_PERIOD     4
+#define PSCHED_BLOCK_TYPES      5
+
+typedef struct psched_prof
+{
+    uint64_t  run_time;                         /* 运行总时间 */
+    uint64_t  run_max;                          /* 最长一次运行 */
+    uint64_t  wake_time;                        /* 唤醒到运行, 总和 */
+    uint64_t  wake_max;
+    uint32_t  wake_count;
+    uint32_t  block_type;                       /* PSCHED_BLOCK_* */
+    uint64_t  ready_at;                         /* 唤醒时刻, 0: 不计 */
+    uint64_t  block_at;                         /* 阻塞开始, 0: 没有阻塞 */
+    uint64_t  block_time[PSCHED_BLOCK_TYPES];
+} psched_prof_t;
+
+typedef struct psched_task psched_task_t;
+typedef struct psched_period psched_period_t;
+
+struct pesudo_arena;
+
+/*
+ * wait: a task wait at most PSCHED_WAIT_MAX objects, every object has a list
+ * of waiters, signal an object only touch its waiters.
+ */
+#define PSCHED_WAIT_MAX         4
+
+struct psched_obj;
+
+typedef struct psched_waiter
+{
+    psched_task_t     *task;
+    struct psched_obj *obj;
+    uint32_t           level;                   /* 0: is_ready(), 其它: level() 达到时就绪 */
+    TAILQ_ENTRY(psched_waiter) node;
+} psched_waiter_t;
+
+TAILQ_HEAD(psched_waitq, psched_waiter);
+
+struct psched_task
+{
+    char      name[PESUDO_NAME_MAX];            /* 名称 */
+    pesudo_task_entry_t entry;                  /* 任务入口 */
+    void     *arg;                              /* 任务参数 */
+
+    uint32_t  prio;                             /* 优先级, 0 最高 */
+    volatile uint32_t state;                    /* 状态 */
+    uint32_t  flags;
+    uint32_t  heap_tag;                         /* 运行时 heap_set_tag(), 默认 HEAP_TAG_APP */
+    struct pesudo_arena *arena;                 /* 工作缓冲区, psched_task_arena_create() */
+
+    pesudo_ctx_t ctx;                           /* PS_FLAG_STACK: 上下文 */
+    void     *stack;                            /* 堆栈 */
+    uint32_t  stack_size;
+
+    uint64_t  wake_tick;                        /* 休眠终止 ticks */
+    pwheel_timer_t wake_timer;                  /* 休眠定时器 */
+
+    psched_waiter_t waiter[PSCHED_WAIT_MAX];    /* 等待的对象 */
+    uint32_t  wait_count;
+    uint32_t  wait_timeout;                     /* 等待超时 ms */
+    int       wait_result;                      /* 等待结果 */
+
+    psched_period_t *period;                    /* PS_FLAG_PERIODIC */
+
+    uint32_t  run_count;                        /* 运行次数 */
+    psched_prof_t prof;                         /* 运行统计 */
+
+    TAILQ_ENTRY(psched_task) node;              /* 就绪队列 */
+    void     *ready;                            /* 所在就绪表 */
+    TAILQ_ENTRY(psched_task) list;              /* 任务链表 */
+};
+
+//-----------------------------------------------------------------------------
+
+psched_task_t *psched_task_create(const char *name,
+                                  uint32_t prio,
+                                  pesudo_task_entry_t entry,
+                                  void *arg);
+
+/*
+ * task with its own stack, it can switch out in any function
+ */
+psched_task_t *psched_task_create_stack(const char *name,
+                                        uint32_t prio,
+                                        uint32_t stack_size,
+                                        pesudo_task_entry_t entry,
+                                        void *arg);
+
+/*
+ * run to completion once, deleted after the entry returns without sleep or
+ * wait, as a init task
+ */
+psched_task_t *psched_task_create_once(const char *name,
+                                       uint32_t prio,
+                                       pesudo_task_entry_t entry,
+                                       void *arg);
+
+void psched_task_delete(psched_task_t *task);
+void psched_task_suspend(psched_task_t *task);
+void psched_task_resume(psched_task_t *task);
+
+/*
+ * current task don't run again in ms, take effect after return, or at once
+ * for task with stack
+ */
+void psched_task_sleep(uint32_t ms);
+
+/*
+ * task with stack: switch out, run again after the other ready tasks
+ */
+void psched_task_yield(void);
+
+/*
+ * make a sleeping task ready now
+ */
+void psched_task_wakeup(psched_task_t *task);
+
+psched_task_t *psched_current(void);
+
+/*
+ * Arena of the task (pesudo_task_ext.h), for the working buffers of one run:
+ * psched_task_arena_alloc() is a pointer bump, a task without stack has its
+ * arena reset after every run, a task with stack resets it by itself at the
+ * end of its cycle. The arena is freed with the task.
+ */
+int   psched_task_arena_create(psched_task_t *task, size_t size);
+void *psched_task_arena_alloc(size_t size);
+void  psched_task_arena_reset(void);
+
+/*
+ * called before a blocking call: return 1 if the current task has no stack,
+ * it is logged once for the task, and the caller must not wait.
+ */
+int psched_check_blocking(const char *func);
+
+psched_task_t *psched_task_list_first(void);
+psched_task_t *psched_task_list_next(psched_task_t *task);
+
+//-----------------------------------------------------------------------------
+// Wait
+//-----------------------------------------------------------------------------
+
+/*
+ * The object can be waited, it is the first member of sem, event and mq (see
+ * pesudo_waitq.h). is_ready() is called in critical section.
+ *
+ * magic is set by psched_obj_init() and cleared by psched_obj_cleanup(), so a
+ * handle of libbsp (osal_sem_create() ...) or a deleted object is rejected
+ * with PSCHED_WAIT_INVAL, its first word is never PSCHED_OBJ_MAGIC.
+ */
+#define PSCHED_OBJ_SEM          1
+#define PSCHED_OBJ_EVENT        2
+#define PSCHED_OBJ_MQ           3
+
+#define PSCHED_OBJ_MAGIC        0x4A424F50      /* "POBJ" */
+
+#if (PSCHED_OBJ_SEM != PSCHED_BLOCK_SEM) || (PSCHED_OBJ_EVENT != PSCHED_BLOCK_EVENT) || \
+    (PSCHED_OBJ_MQ != PSCHED_BLOCK_MQ)
+#error "PSCHED_BLOCK_* must be same as PSCHED_OBJ_*"
+#endif
+
+typedef struct psched_obj psched_obj_t;
+
+struct psched_obj
+{
+    uint32_t  magic;                            /* PSCHED_OBJ_MAGIC */
+    uint32_t  type;
+    uint32_t  opt;                              /* OSAL_OPT_FIFO/LIFO/PRIO/ALL */
+    char      name[PESUDO_NAME_MAX];
+    int     (*is_ready)(psched_obj_t *obj);
+    uint32_t (*level)(psched_obj_t *obj);       /* 可选, 已有的数量 */
+    struct psched_waitq waitq;                  /* 等待的任务 */
+};
+
+/*
+ * the handle is a psched object, not of libbsp or deleted
+ */
+static inline int psched_obj_valid(const void *obj)
+{
+    return obj && !((uintptr_t)obj & 3) &&
+           (((const psched_obj_t *)obj)->magic == PSCHED_OBJ_MAGIC);
+}
+
+/*
+ * wait result
+ */
+#define PSCHED_WAIT_NONE        (-1)            /* 没有等待, 或者已在等待 */
+#define PSCHED_WAIT_TIMEOUT     (-2)            /* 超时 */
+#define PSCHED_WAIT_DELETED     (-3)            /* 对象被删除 */
+#define PSCHED_WAIT_INVAL       (-4)            /* 参数错误 */
+
+/*
+ * Wait any of the objects. If one is ready now, return its index and the task
+ * go on. PSCHED_WAIT_INVAL if one is not a psched object. Otherwise return PSCHED_WAIT_NONE, after the task return it is not
+ * run until one object is ready or timeout, then psched_wait_result() tell
+ * why it run. The object is not taken, the task take it without waiting.
+ *
+ * Task with stack switch out at once, and return the result when it run.
+ */
+int psched_wait_any(void *objs[], int n, uint32_t timeout_ms);
+
+/*
+ * Wait the object until it has level items (obj->level() >= level), other
+ * waiters of the object are not affected. Return as psched_wait_any(), the
+ * index is 0. PSCHED_WAIT_INVAL if the object has no level().
+ */
+int psched_wait_level(void *obj, uint32_t level, uint32_t timeout_ms);
+
+/*
+ * why the current task run: index of the object, PSCHED_WAIT_TIMEOUT,
+ * PSCHED_WAIT_DELETED, or PSCHED_WAIT_NONE if it was not waiting.
+ */
+int psched_wait_result(void);
+
+/*
+ * for the objects
+ */
+void psched_obj_init(psched_obj_t *obj, uint32_t type, const char *name,
+                     uint32_t opt, int (*is_ready)(psched_obj_t *obj));
+
+/*
+ * wake up to count waiters, count < 0 or OSAL_OPT_ALL wake all. A waiter of
+ * psched_wait_level() is skipped until its level is reached. Return count of
+ * waked. Called in critical section.
+ */
+int psched_obj_wake(psched_obj_t *obj, int count);
+
+/*
+ * wake all waiters with PSCHED_WAIT_DELETED
+ */
+void psched_obj_cleanup(psched_obj_t *obj);
+
+/*
+ * Memory of the objects: a block of PSCHED_OBJ_POOL_SIZE bytes from the
+ * osal_pool of the objects, O(1) without the heap lock; larger ones, or
+ * when the pool is empty, by malloc(). psched_obj_free() frees either.
+ */
+#define PSCHED_OBJ_POOL_SIZE    128
+#define PSCHED_OBJ_POOL_COUNT   64
+
+void *psched_obj_alloc(size_t size);
+void psched_obj_free(void *ptr);
+
+//-----------------------------------------------------------------------------
+// Timer
+//-----------------------------------------------------------------------------
+
+/*
+ * The timers are in the timing wheel of pesudo_sched, the callback is called
+ * in pesudo_sched_run() of the main loop. The minimum timeout is 1 tick,
+ * instead of PESUDO_TIMER_MS_MIN of the timers in libbsp.
+ */
+#define PSCHED_TIMER_MS_MIN     1
+
+typedef struct psched_timer psched_timer_t;
+
+struct psched_timer
+{
+    char      name[PESUDO_NAME_MAX];            /* 名称 */
+    pesudo_task_entry_t callback;               /* 回调函数 */
+    void     *arg;                              /* 回调参数 */
+    uint32_t  timeout_ms;                       /* 定时 */
+    int       is_period;                        /* 周期定时 */
+    pwheel_timer_t wt;
+};
+
+psched_timer_t *psched_timer_create(const char *name,
+                                    pesudo_task_entry_t entry,
+                                    void *argument,
+                                    uint32_t timeout_ms,
+                                    bool is_period);
+void psched_timer_delete(psched_timer_t *tmr);
+
+/*
+ * timeout_ms == 0: use the timeout when created
+ */
+int psched_timer_start(psched_timer_t *tmr, uint32_t timeout_ms);
+int psched_timer_stop(psched_timer_t *tmr);
+
+//-----------------------------------------------------------------------------
+// Periodic
+//-----------------------------------------------------------------------------
+
+/*
+ * A periodic task is released every period_us on a fixed grid of the stable
+ * counter, so it doesn't drift as sleep() after the work. The entry is called
+ * once for a release (run to completion), it should not sleep or wait.
+ *
+ * For every job: jitter = start - release, exec = end - start. The job
+ * misses the deadline if end - release > deadline_us, the overrun hook is
+ * called then. A release while the last job is not done yet is skipped.
+ *
+ * The idle deadline is in ms, so the main loop spin the last ms before a
+ * release.
+ */
+typedef void (*psched_overrun_hook_t)(psched_task_t *task, uint32_t late_us);
+
+typedef struct psched_period_stats
+{
+    uint32_t  period_us;
+    uint32_t  deadline_us;
+    uint32_t  releases;                         /* 释放次数 */
+    uint32_t  misses;                           /* 超过截止时间 */
+    uint32_t  skipped;                          /* 上一次未完成, 跳过的释放 */
+    uint32_t  jitter_max_us;                    /* 释放到开始运行 */
+    uint64_t  jitter_sum_us;
+    uint32_t  exec_us;                          /* 最近一次运行时间 */
+    uint32_t  exec_max_us;
+    uint64_t  exec_sum_us;
+    uint32_t  late_max_us;                      /* 超过截止时间最多 */
+} psched_period_stats_t;
+
+struct psched_period
+{
+    uint64_t  period;                           /* stable counter */
+    uint64_t  deadline;
+    uint64_t  release;                          /* 本次释放 */
+    uint64_t  next_release;                     /* 下次释放 */
+    psched_overrun_hook_t overrun;
+    psched_period_stats_t stats;
+    TAILQ_ENTRY(psched_period) node;
+    psched_task_t *task;
+};
+
+/*
+ * priority of rate monotonic: the shorter period, the higher priority
+ */
+uint32_t psched_rm_prio(uint32_t period_us);
+
+/*
+ * deadline_us == 0: deadline is the period. First release is now.
+ */
+psched_task_t *psched_task_create_periodic(const char *name,
+                                           uint32_t prio,
+                                           uint32_t period_us,
+                                           uint32_t deadline_us,
+                                           pesudo_task_entry_t entry,
+                                           void *arg);
+
+void psched_task_set_overrun_hook(psched_task_t *task, psched_overrun_hook_t hook);
+
+int psched_task_period_stats(psched_task_t *task, psched_period_stats_t *stats);
+void psched_task_period_stats_reset(psched_task_t *task);
+
+//-----------------------------------------------------------------------------
+
+/*
+ * run a pass, return the count of task run
+ */
+int pesudo_sched_run(void);
+
+#define PSCHED_TICK_NEVER       (~(uint64_t)0)
+
+/*
+ * the tick when a task or timer will be ready, for idle. It is not later than
+ * get_clock_ticks() if a task is ready now, PSCHED_TICK_NEVER if nothing.
+ */
+uint64_t pesudo_sched_next_tick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_SCHED_H
+
+/*
+ * @@ END
+ */
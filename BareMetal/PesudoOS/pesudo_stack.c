@@ -0,0 +1,201 @@
+/*
+ * pesudo_stack.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+#include "pesudo_sched.h"
+#include "pesudo_task.h"
+#include "pesudo_task_ext.h"
+#include "pesudo_prof.h"
+#include "pesudo_stack.h"
+
+//-----------------------------------------------------------------------------
+
+void pesudo_stack_paint(void *base, size_t size)
+{
+    size_t *p = (size_t *)base;
+    size_t i, n = size / sizeof(size_t);
+
+    for (i=0; i<n; i++)
+    {
+        p[i] = PESUDO_STACK_FILL;
+    }
+}
+
+size_t pesudo_stack_unused(const void *base, size_t size)
+{
+    const size_t *p = (const size_t *)base;
+    size_t i, n = size / sizeof(size_t);
+
+    for (i=0; i<n; i++)
+    {
+        if (p[i] != PESUDO_STACK_FILL)
+            break;
+    }
+
+    return i * sizeof(size_t);
+}
+
+//-----------------------------------------------------------------------------
+// libbsp tasks
+//-----------------------------------------------------------------------------
+
+/*
+ * stack_base[0] 是 PESUDO_STACK_MAGIC, 从 [1] 开始填充
+ */
+static inline size_t *task_paint_base(struct pesudo_task *task)
+{
+    return task->stack_base + 1;
+}
+
+static inline size_t task_paint_size(struct pesudo_task *task)
+{
+    return task->stack_size - sizeof(size_t) - PESUDO_STACK_TOP_SKIP;
+}
+
+static inline struct pesudo_task_ext *task_stack_ext(struct pesudo_task *task)
+{
+    struct pesudo_task_ext *ext = (struct pesudo_task_ext *)task->user_data;
+
+    if (ext && (ext->magic == PESUDO_TASK_EXT_MAGIC) &&
+        (ext->stack_flags & PESUDO_STACK_PAINTED))
+    {
+        return ext;
+    }
+
+    return NULL;
+}
+
+int pesudo_stack_paint_all(void)
+{
+    struct pesudo_task *task;
+    struct pesudo_task_ext *ext;
+    int count = 0;
+
+    for (task = pesudoos_task_list_first(); task != NULL;
+         task = pesudoos_task_list_next(task))
+    {
+        /*
+         * 运行过的任务栈上有数据
+         */
+        if (!(task->state & PT_STATE_IDLE) || !task->stack_base ||
+            (task->stack_size < PESUDO_STACK_MIN))
+        {
+            continue;
+        }
+
+        ext = pesudo_task_ext(task);
+        if (!ext || (ext->stack_flags & PESUDO_STACK_PAINTED))
+        {
+            continue;
+        }
+
+        pesudo_stack_paint(task_paint_base(task), task_paint_size(task));
+        ext->stack_flags |= PESUDO_STACK_PAINTED;
+        count++;
+    }
+
+    return count;
+}
+
+int pesudo_stack_check(void)
+{
+    struct pesudo_task *task;
+    struct pesudo_task_ext *ext;
+    int count = 0;
+
+    for (task = pesudoos_task_list_first(); task != NULL;
+         task = pesudoos_task_list_next(task))
+    {
+        ext = task_stack_ext(task);
+        if (!ext || (ext->stack_flags & PESUDO_STACK_OVERFLOW))
+        {
+            continue;
+        }
+
+        if (!pesudo_stack_guard_ok(task_paint_base(task)))
+        {
+            ext->stack_flags |= PESUDO_STACK_OVERFLOW;
+            task->error |= PT_FATAL_STACK_OV;
+
+            LOG_ERR("task %s stack overflow, size %u\r\n",
+                    task->task_name, (unsigned)task->stack_size);
+
+            pesudo_task_suspend(task);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+// Report
+//-----------------------------------------------------------------------------
+
+int pesudo_stack_report(pesudo_stack_info_t *info, int max)
+{
+    psched_task_t *pt;
+    struct pesudo_task *lt;
+    struct pesudo_task_ext *ext;
+    size_t flag;
+    int count = 0;
+
+    if (!info || (max <= 0))
+    {
+        return 0;
+    }
+
+    flag = osal_enter_critical_section();
+
+    for (pt = psched_task_list_first(); pt && (count < max);
+         pt = psched_task_list_next(pt))
+    {
+        if (!(pt->flags & PS_FLAG_STACK))
+        {
+            continue;
+        }
+
+        info[count].name     = pt->name;
+        info[count].kind     = PESUDO_STATS_PSCHED;
+        info[count].size     = pt->stack_size;
+        info[count].used     = pt->stack_size - pesudo_stack_unused(pt->stack, pt->stack_size);
+        info[count].overflow = (pt->flags & PS_FLAG_STACK_OV) ? 1 : 0;
+        count++;
+    }
+
+    for (lt = pesudoos_task_list_first(); lt && (count < max);
+         lt = pesudoos_task_list_next(lt))
+    {
+        if (!lt->stack_base)
+        {
+            continue;
+        }
+
+        info[count].name     = lt->task_name;
+        info[count].kind     = PESUDO_STATS_LIBBSP;
+        info[count].size     = lt->stack_size;
+        info[count].used     = 0;
+        info[count].overflow = (lt->error & PT_FATAL_STACK_OV) ? 1 : 0;
+
+        ext = task_stack_ext(lt);
+        if (ext)
+        {
+            info[count].used = lt->stack_size - sizeof(size_t) -
+                pesudo_stack_unused(task_paint_base(lt), task_paint_size(lt));
+        }
+
+        count++;
+    }
+
+    osal_leave_critical_section(flag);
+
+    return count;
+}
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,111 @@
+/*
+ * pesudo_stack.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Task stack painting and overflow check.
+ *
+ * A stack is filled with PESUDO_STACK_FILL before the task first run. The
+ * stack grows down, so the words at the low end that still have the fill are
+ * never used: high-water mark = size - unused.
+ *
+ * The lowest PESUDO_STACK_GUARD_WORDS words (above the PESUDO_STACK_MAGIC
+ * word of libbsp) are the guard. They are compared after a task switch out:
+ *
+ *   pesudo_sched tasks with stack: in pesudo_sched_run() after every switch.
+ *   libbsp tasks: pesudo_stack_check() in the main loop after pesudoos_run().
+ *
+ * A task with a broken guard is suspended, and PT_FATAL_STACK_OV is set for
+ * the libbsp task. The memory below the stack may be broken already, so it is
+ * a fatal error to fix the stack size, not to recover.
+ */
+
+#ifndef _PESUDO_STACK_H
+#define _PESUDO_STACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+
+#define PESUDO_STACK_FILL       ((size_t)0xCCCCCCCCCCCCCCCCULL)
+#define PESUDO_STACK_GUARD_WORDS    4           /* 栈底保护区 */
+
+/*
+ * libbsp 任务栈顶部不填充, 创建时可能已有初始数据
+ */
+#define PESUDO_STACK_TOP_SKIP   256
+
+/*
+ * flags of pesudo_task_ext
+ */
+#define PESUDO_STACK_PAINTED    0x0001          /* 已填充 */
+#define PESUDO_STACK_OVERFLOW   0x0002          /* 保护区被破坏 */
+
+//-----------------------------------------------------------------------------
+
+void pesudo_stack_paint(void *base, size_t size);
+
+/*
+ * bytes never used from the low end
+ */
+size_t pesudo_stack_unused(const void *base, size_t size);
+
+static inline int pesudo_stack_guard_ok(const void *base)
+{
+    const size_t *p = (const size_t *)base;
+    int i;
+
+    for (i=0; i<PESUDO_STACK_GUARD_WORDS; i++)
+    {
+        if (p[i] != PESUDO_STACK_FILL)
+            return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * paint the stacks of libbsp tasks not run yet, call it before main loop
+ */
+int pesudo_stack_paint_all(void);
+
+/*
+ * check the guards of libbsp tasks, return count of overflow found
+ */
+int pesudo_stack_check(void);
+
+//-----------------------------------------------------------------------------
+// Report
+//-----------------------------------------------------------------------------
+
+typedef struct pesudo_stack_info
+{
+    const char *name;
+    uint32_t  kind;                             /* PESUDO_STATS_PSCHED/LIBBSP */
+    uint32_t  size;                             /* 堆栈大小 */
+    uint32_t  used;                             /* 最多使用, 0: 未填充 */
+    uint32_t  overflow;
+} pesudo_stack_info_t;
+
+/*
+ * fill at most max tasks with stack, return the count filled
+ */
+int pesudo_stack_report(pesudo_stack_info_t *info, int max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_STACK_H
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,136 @@
+/*
+ * pesudo_task_ext.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "pesudo_task_ext.h"
+
+#ifndef align_up
+#define align_up(num, align)    (((num) + ((align)-1)) & ~((align)-1))
+#endif
+
+//-----------------------------------------------------------------------------
+// Arena
+//-----------------------------------------------------------------------------
+
+int pesudo_arena_init(pesudo_arena_t *arena, size_t size)
+{
+    if (!arena || (size == 0))
+    {
+        return -1;
+    }
+
+    memset(arena, 0, sizeof(pesudo_arena_t));
+
+    size = align_up(size, PESUDO_ARENA_ALIGN);
+
+    arena->base = (unsigned char *)malloc(size);
+    if (!arena->base)
+    {
+        return -1;
+    }
+
+    arena->size = size;
+
+    return 0;
+}
+
+void pesudo_arena_free(pesudo_arena_t *arena)
+{
+    if (arena && arena->base)
+    {
+        free(arena->base);
+        memset(arena, 0, sizeof(pesudo_arena_t));
+    }
+}
+
+void *pesudo_arena_alloc(pesudo_arena_t *arena, size_t size)
+{
+    void *ptr;
+
+    if (!arena || !arena->base || (size == 0))
+    {
+        return NULL;
+    }
+
+    size = align_up(size, PESUDO_ARENA_ALIGN);
+
+    if (size > arena->size - arena->used)
+    {
+        arena->fail_count++;
+        return NULL;
+    }
+
+    ptr = arena->base + arena->used;
+    arena->used += size;
+
+    if (arena->used > arena->peak)
+    {
+        arena->peak = arena->used;
+    }
+
+    return ptr;
+}
+
+void pesudo_arena_reset(pesudo_arena_t *arena)
+{
+    if (arena)
+    {
+        arena->used = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Task extension
+//-----------------------------------------------------------------------------
+
+static inline struct pesudo_task_ext *task_ext_get(struct pesudo_task *task)
+{
+    struct pesudo_task_ext *ext = (struct pesudo_task_ext *)task->user_data;
+
+    return (ext && (ext->magic == PESUDO_TASK_EXT_MAGIC)) ? ext : NULL;
+}
+
+struct pesudo_task_ext *pesudo_task_ext(struct pesudo_task *task)
+{
+    struct pesudo_task_ext *ext;
+
+    if (!task)
+    {
+        return NULL;
+    }
+
+    ext = task_ext_get(task);
+    if (ext)
+    {
+        return ext;
+    }
+
+    /*
+     * user_data is used by others
+     */
+    if (task->user_data)
+    {
+        return NULL;
+    }
+
+    ext = (struct pesudo_task_ext *)calloc(1, sizeof(struct pesudo_task_ext));
+    if (!ext)
+    {
+        return NULL;
+    }
+
+    ext->magic = PESUDO_TASK_EXT_MAGIC;
+    task->user_data = ext;
+
+    return ext;
+}
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,82 @@
+/*
+ * pesudo_task_ext.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Task extension.
+ *
+ * struct pesudo_task is compiled in libbsp, it can't be changed. The extension
+ * is attached to task->user_data, so the application use ext->user_data
+ * instead after the extension is created.
+ *
+ * Arena: a bump pointer region, for the working buffers of one processing
+ * cycle. Allocation is a pointer bump, all is released at once by reset. The
+ * tasks of the application are psched tasks, their arena is
+ * psched_task_arena_create() of pesudo_sched.h.
+ */
+
+#ifndef _PESUDO_TASK_EXT_H
+#define _PESUDO_TASK_EXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pesudoos.h"
+#include "pesudo_task.h"
+
+//-----------------------------------------------------------------------------
+// Arena
+//-----------------------------------------------------------------------------
+
+#define PESUDO_ARENA_ALIGN      8
+
+typedef struct pesudo_arena
+{
+    unsigned char *base;                        /* 起始地址 */
+    size_t         size;                        /* 大小 */
+    size_t         used;                        /* 已分配 */
+    size_t         peak;                        /* 分配峰值, 用于确定 size */
+    uint32_t       fail_count;                  /* 空间不够次数 */
+} pesudo_arena_t;
+
+int  pesudo_arena_init(pesudo_arena_t *arena, size_t size);
+void pesudo_arena_free(pesudo_arena_t *arena);
+
+void *pesudo_arena_alloc(pesudo_arena_t *arena, size_t size);
+void  pesudo_arena_reset(pesudo_arena_t *arena);
+
+//-----------------------------------------------------------------------------
+// Task extension
+//-----------------------------------------------------------------------------
+
+#define PESUDO_TASK_EXT_MAGIC   0x54455854      /* "TEXT" */
+
+struct pesudo_task_ext
+{
+    uint32_t        magic;
+    uint32_t        stack_flags;                /* 堆栈检查, pesudo_stack.h */
+    void           *user_data;                  /* 代替 task->user_data */
+};
+
+/*
+ * get the extension, create it if not exists. NULL if task->user_data is used
+ * by others or no memory.
+ */
+struct pesudo_task_ext *pesudo_task_ext(struct pesudo_task *task);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_TASK_EXT_H
+
+/*
+ * @@ END
+ */
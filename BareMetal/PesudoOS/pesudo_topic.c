@@ -0,0 +1,380 @@
+/*
+ * pesudo_topic.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pesudo_topic.h"
+
+//-----------------------------------------------------------------------------
+
+static topic_t *m_topics = NULL;
+
+#define TOPIC_ALIGN(x)          (((x) + 7) & ~7U)
+
+/*
+ * DMA 的池块: 负载从第二个 cache line 开始, topic_msg_t 在它前面
+ *
+ *     | 空 | topic_msg_t | data ...  |
+ *     ^ 块               ^ OSAL_POOL_DMA_ALIGN
+ */
+static inline size_t topic_slot_size(topic_t *topic)
+{
+    if (topic->opt & TOPIC_OPT_DMA)
+    {
+        return OSAL_POOL_DMA_ALIGN + topic->msg_size;
+    }
+
+    return sizeof(topic_msg_t) + TOPIC_ALIGN(topic->msg_size);
+}
+
+static inline topic_msg_t *topic_msg_of(const void *data)
+{
+    return (topic_msg_t *)((const char *)data - offsetof(topic_msg_t, data));
+}
+
+/*
+ * 在临界区中调用, 最后一个引用释放后回到 topic 的 osal_pool
+ */
+static void topic_msg_put(topic_msg_t *msg)
+{
+    if (--msg->ref == 0)
+    {
+        osal_pool_free(msg->topic->pool, (char *)msg - msg->topic->msg_offset);
+    }
+}
+
+static int topic_sub_is_ready(psched_obj_t *obj)
+{
+    return ((topic_sub_t *)obj)->count > 0;
+}
+
+//-----------------------------------------------------------------------------
+// Topic
+//-----------------------------------------------------------------------------
+
+topic_t *topic_create(const char *name, uint32_t opt, uint32_t msg_size, uint32_t msg_count)
+{
+    topic_t *topic;
+    size_t flag;
+
+    if (!name || (msg_size == 0) || (msg_count == 0) || topic_find(name))
+    {
+        LOG_ERR("create topic %s fail\r\n", name ? name : "");
+        return NULL;
+    }
+
+    topic = (topic_t *)calloc(1, sizeof(topic_t));
+    if (!topic)
+    {
+        LOG_ERR("create topic %s fail\r\n", name);
+        return NULL;
+    }
+
+    topic->msg_size  = msg_size;
+    topic->msg_count = msg_count;
+    topic->opt       = opt;
+
+    if (opt & TOPIC_OPT_DMA)
+    {
+        topic->msg_offset = OSAL_POOL_DMA_ALIGN - offsetof(topic_msg_t, data);
+        topic->pool = osal_pool_create_dma(name, (uint32_t)topic_slot_size(topic), msg_count);
+    }
+    else
+    {
+        topic->pool = osal_pool_create(name, (uint32_t)topic_slot_size(topic), msg_count);
+    }
+
+    if (!topic->pool)
+    {
+        free(topic);
+        LOG_ERR("create topic %s fail\r\n", name);
+        return NULL;
+    }
+
+    strncpy(topic->name, name, PESUDO_NAME_MAX - 1);
+
+    flag = osal_enter_critical_section();
+    topic->next = m_topics;
+    m_topics    = topic;
+    osal_leave_critical_section(flag);
+
+    return topic;
+}
+
+topic_t *topic_find(const char *name)
+{
+    topic_t *topic;
+
+    if (!name)
+    {
+        return NULL;
+    }
+
+    for (topic = m_topics; topic; topic = topic->next)
+    {
+        if (strncmp(topic->name, name, PESUDO_NAME_MAX - 1) == 0)
+        {
+            break;
+        }
+    }
+
+    return topic;
+}
+
+topic_t *topic_list_first(void)
+{
+    return m_topics;
+}
+
+topic_t *topic_list_next(topic_t *topic)
+{
+    return topic ? topic->next : NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Publish
+//-----------------------------------------------------------------------------
+
+void *topic_loan(topic_t *topic)
+{
+    topic_msg_t *msg;
+    char *blk;
+
+    if (!topic)
+    {
+        return NULL;
+    }
+
+    blk = (char *)osal_pool_alloc(topic->pool);
+    if (!blk)
+    {
+        topic->no_buffer++;
+        return NULL;
+    }
+
+    msg = (topic_msg_t *)(blk + topic->msg_offset);
+
+    msg->topic = topic;
+    msg->ref   = 1;                             /* 发布者的引用 */
+
+    return msg->data;
+}
+
+void topic_unloan(void *data)
+{
+    size_t flag;
+
+    if (!data)
+    {
+        return;
+    }
+
+    flag = osal_enter_critical_section();
+    topic_msg_put(topic_msg_of(data));
+    osal_leave_critical_section(flag);
+}
+
+int topic_publish(topic_t *topic, void *data)
+{
+    topic_msg_t *msg;
+    topic_sub_t *sub;
+    size_t flag;
+    int count = 0;
+
+    if (!topic || !data)
+    {
+        return -1;
+    }
+
+    msg = topic_msg_of(data);
+    if ((msg->topic != topic) || (msg->ref == 0))
+    {
+        return -1;
+    }
+
+    flag = osal_enter_critical_section();
+
+    msg->seq = ++topic->seq;
+    topic->published++;
+
+    for (sub = topic->subs; sub; sub = sub->next)
+    {
+        if (sub->count >= sub->depth)
+        {
+            sub->dropped++;
+
+            if (sub->policy == TOPIC_POLICY_DROP_NEWEST)
+            {
+                continue;
+            }
+
+            topic_msg_put(sub->ring[sub->head]);
+            if (++sub->head == sub->depth)
+            {
+                sub->head = 0;
+            }
+            sub->count--;
+        }
+
+        sub->ring[(sub->head + sub->count) % sub->depth] = msg;
+        sub->count++;
+        sub->received++;
+        msg->ref++;
+        count++;
+
+        psched_obj_wake(&sub->obj, 1);
+    }
+
+    /*
+     * 没有订阅者时直接回到 topic 的池
+     */
+    topic_msg_put(msg);
+
+    osal_leave_critical_section(flag);
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+// Subscribe
+//-----------------------------------------------------------------------------
+
+topic_sub_t *topic_subscribe(topic_t *topic, uint32_t depth, uint32_t policy)
+{
+    topic_sub_t *sub;
+    size_t flag;
+
+    if (!topic || (depth == 0))
+    {
+        return NULL;
+    }
+
+    sub = (topic_sub_t *)psched_obj_alloc(sizeof(topic_sub_t));
+    if (sub)
+    {
+        memset(sub, 0, sizeof(topic_sub_t));
+        sub->ring = (topic_msg_t **)psched_obj_alloc(sizeof(topic_msg_t *) * depth);
+    }
+
+    if (!sub || !sub->ring)
+    {
+        psched_obj_free(sub);
+        LOG_ERR("subscribe topic %s fail\r\n", topic->name);
+        return NULL;
+    }
+
+    psched_obj_init(&sub->obj, PSCHED_OBJ_MQ, topic->name, 0, topic_sub_is_ready);
+
+    sub->topic  = topic;
+    sub->policy = policy;
+    sub->depth  = depth;
+
+    flag = osal_enter_critical_section();
+    sub->next   = topic->subs;
+    topic->subs = sub;
+    osal_leave_critical_section(flag);
+
+    return sub;
+}
+
+void topic_unsubscribe(topic_sub_t *sub)
+{
+    topic_sub_t **pp;
+    size_t flag;
+
+    if (!sub)
+    {
+        return;
+    }
+
+    flag = osal_enter_critical_section();
+
+    for (pp = &sub->topic->subs; *pp; pp = &(*pp)->next)
+    {
+        if (*pp == sub)
+        {
+            *pp = sub->next;
+            break;
+        }
+    }
+
+    while (sub->count > 0)
+    {
+        topic_msg_put(sub->ring[sub->head]);
+        if (++sub->head == sub->depth)
+        {
+            sub->head = 0;
+        }
+        sub->count--;
+    }
+
+    osal_leave_critical_section(flag);
+
+    psched_obj_cleanup(&sub->obj);
+    psched_obj_free(sub->ring);
+    psched_obj_free(sub);
+}
+
+int topic_sub_valid(const void *sub)
+{
+    return psched_obj_valid(sub) && (((const topic_sub_t *)sub)->obj.is_ready == topic_sub_is_ready);
+}
+
+int topic_receive(topic_sub_t *sub, const void **data)
+{
+    topic_msg_t *msg;
+    size_t flag;
+
+    if (!sub || !data)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (sub->count == 0)
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_TIMEOUT;
+    }
+
+    /*
+     * 队列的引用交给接收者
+     */
+    msg = sub->ring[sub->head];
+    if (++sub->head == sub->depth)
+    {
+        sub->head = 0;
+    }
+    sub->count--;
+
+    osal_leave_critical_section(flag);
+
+    *data = msg->data;
+
+    return OSAL_ERR_OK;
+}
+
+void topic_release(const void *data)
+{
+    size_t flag;
+
+    if (!data)
+    {
+        return;
+    }
+
+    flag = osal_enter_critical_section();
+    topic_msg_put(topic_msg_of(data));
+    osal_leave_critical_section(flag);
+}
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,159 @@
+/*
+ * pesudo_topic.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Topic bus, publish/subscribe with shared payloads.
+ *
+ * A topic has a pool of msg_count payloads of msg_size bytes. The producer
+ * loans a payload, writes it in place and publishes it. Every subscriber gets
+ * a reference of the same payload in its own queue, the payload is back to
+ * the pool when the last one releases it. So a new subscriber costs no copy
+ * and no change of the producer:
+ *
+ *     topic_t *t = topic_create("radar/scan", 0, SCAN_BYTES, 4);
+ *
+ *     void *p = topic_loan(t);                    // NULL: no free payload
+ *     fill(p);
+ *     topic_publish(t, p);
+ *
+ *     topic_sub_t *sub = topic_subscribe(topic_find("radar/scan"), 2,
+ *                                        TOPIC_POLICY_DROP_OLDEST);
+ *     const void *msg;
+ *     if (topic_receive(sub, &msg) == OSAL_ERR_OK)
+ *     {
+ *         use(msg);
+ *         topic_release(msg);
+ *     }
+ *     else
+ *         psched_wait_any((void **)&sub, 1, timeout);
+ *
+ * A subscription is a psched object, it is waited by psched_wait_any() or
+ * await_topic() of pesudo_pt.h. The operations never block.
+ *
+ * The pool (an osal_pool, at most OSAL_POOL_MAX_ITEMS) should have a payload
+ * for the producer, depth of every subscriber and the ones in use, or
+ * topic_loan() fails till a payload is released.
+ *
+ * With TOPIC_OPT_DMA the pool is osal_pool_create_dma(): a payload starts at
+ * a cache line and has its cache lines alone, it can be flushed and given to
+ * DMA in place.
+ */
+
+#ifndef _PESUDO_TOPIC_H
+#define _PESUDO_TOPIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "osal.h"
+#include "pesudo_sched.h"
+
+//-----------------------------------------------------------------------------
+
+/*
+ * subscriber queue is full
+ */
+#define TOPIC_POLICY_DROP_OLDEST    0           /* 丢弃最旧的, 保留最新数据 */
+#define TOPIC_POLICY_DROP_NEWEST    1           /* 不接收新的消息 */
+
+/*
+ * topic_create() opt
+ */
+#define TOPIC_OPT_DMA               0x0001      /* 负载可以直接交给 DMA */
+
+typedef struct topic_msg
+{
+    struct topic *topic;
+    uint32_t  ref;                              /* 引用计数, 0: 空闲 */
+    uint32_t  seq;                              /* 发布序号 */
+    uint64_t  data[];                           /* 8 字节对齐 */
+} topic_msg_t;
+
+typedef struct topic_sub
+{
+    psched_obj_t obj;                           /* 第一个成员, 可等待 */
+    struct topic *topic;
+    uint32_t  policy;
+    uint32_t  depth;
+    uint32_t  head;
+    uint32_t  count;
+    uint32_t  received;                         /* 收到的消息 */
+    uint32_t  dropped;                          /* 队列满丢弃的消息 */
+    struct topic_sub *next;
+    topic_msg_t **ring;
+} topic_sub_t;
+
+typedef struct topic
+{
+    char      name[PESUDO_NAME_MAX];
+    uint32_t  msg_size;
+    uint32_t  msg_count;
+    uint32_t  opt;                              /* TOPIC_OPT_* */
+    uint32_t  msg_offset;                       /* topic_msg_t 在池块中的位置 */
+    uint32_t  seq;
+    uint32_t  published;                        /* 发布次数 */
+    uint32_t  no_buffer;                        /* topic_loan() 失败次数 */
+    topic_sub_t *subs;
+    struct topic *next;
+    osal_pool_t pool;                           /* msg_count 块, 每块一个 topic_msg_t */
+} topic_t;
+
+//-----------------------------------------------------------------------------
+
+topic_t *topic_create(const char *name, uint32_t opt, uint32_t msg_size, uint32_t msg_count);
+
+/*
+ * the topic created by name, NULL if not found
+ */
+topic_t *topic_find(const char *name);
+
+/*
+ * a free payload of msg_size bytes, NULL if the pool is empty
+ */
+void *topic_loan(topic_t *topic);
+
+/*
+ * give the loaned payload to all subscribers, return count of subscribers
+ * that got it. The producer must not touch it later.
+ */
+int topic_publish(topic_t *topic, void *data);
+
+/*
+ * give back a loaned payload not published
+ */
+void topic_unloan(void *data);
+
+topic_sub_t *topic_subscribe(topic_t *topic, uint32_t depth, uint32_t policy);
+void topic_unsubscribe(topic_sub_t *sub);
+
+/*
+ * the handle is a subscription, not unsubscribed
+ */
+int topic_sub_valid(const void *sub);
+
+/*
+ * OSAL_ERR_OK: *data is the oldest message, topic_release() it after use.
+ * OSAL_ERR_TIMEOUT: empty
+ */
+int topic_receive(topic_sub_t *sub, const void **data);
+void topic_release(const void *data);
+
+topic_t *topic_list_first(void);
+topic_t *topic_list_next(topic_t *topic);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_TOPIC_H
+
+/*
+ * @@ END
+ */
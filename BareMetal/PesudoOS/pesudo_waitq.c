@@ -0,0 +1,998 @@
+/*
+ * pesudo_waitq.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include <string.h>
+
+#include "pesudo_waitq.h"
+
+//-----------------------------------------------------------------------------
+// Semaphore
+//-----------------------------------------------------------------------------
+
+static int sem_is_ready(psched_obj_t *obj)
+{
+    return ((psched_sem_t *)obj)->count > 0;
+}
+
+psched_sem_t *psched_sem_create(const char *name, uint32_t opt, uint32_t initial_count)
+{
+    psched_sem_t *sem;
+
+    sem = (psched_sem_t *)psched_obj_alloc(sizeof(psched_sem_t));
+    if (!sem)
+    {
+        LOG_ERR(STR_OSAL_CREATE_SEM_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    psched_obj_init(&sem->obj, PSCHED_OBJ_SEM, name, opt, sem_is_ready);
+    sem->count = initial_count;
+
+    return sem;
+}
+
+void psched_sem_delete(psched_sem_t *sem)
+{
+    if (sem)
+    {
+        psched_obj_cleanup(&sem->obj);
+        psched_obj_free(sem);
+    }
+}
+
+int psched_sem_obtain(psched_sem_t *sem)
+{
+    size_t flag;
+    int rt = OSAL_ERR_TIMEOUT;
+
+    if (!sem)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (sem->count > 0)
+    {
+        sem->count--;
+        rt = OSAL_ERR_OK;
+    }
+
+    osal_leave_critical_section(flag);
+
+    return rt;
+}
+
+int psched_sem_release(psched_sem_t *sem)
+{
+    size_t flag;
+
+    if (!sem)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    sem->count++;
+    psched_obj_wake(&sem->obj, 1);
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Event
+//-----------------------------------------------------------------------------
+
+static int event_is_ready(psched_obj_t *obj)
+{
+    return ((psched_event_t *)obj)->bits != 0;
+}
+
+psched_event_t *psched_event_create(const char *name, uint32_t opt)
+{
+    psched_event_t *event;
+
+    event = (psched_event_t *)psched_obj_alloc(sizeof(psched_event_t));
+    if (!event)
+    {
+        LOG_ERR(STR_OSAL_CREATE_EVENT_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    psched_obj_init(&event->obj, PSCHED_OBJ_EVENT, name, opt, event_is_ready);
+    event->bits = 0;
+
+    return event;
+}
+
+void psched_event_delete(psched_event_t *event)
+{
+    if (event)
+    {
+        psched_obj_cleanup(&event->obj);
+        psched_obj_free(event);
+    }
+}
+
+int psched_event_send(psched_event_t *event, uint32_t bits)
+{
+    size_t flag;
+
+    if (!event)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    event->bits |= bits;
+    psched_obj_wake(&event->obj, -1);
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+uint32_t psched_event_receive(psched_event_t *event, uint32_t bits, uint32_t flag)
+{
+    uint32_t got = 0;
+    size_t cs;
+
+    if (!event || !bits)
+    {
+        return 0;
+    }
+
+    cs = osal_enter_critical_section();
+
+    if (flag & OSAL_EVENT_FLAG_AND)
+    {
+        if ((event->bits & bits) == bits)
+            got = bits;
+    }
+    else
+    {
+        got = event->bits & bits;
+    }
+
+    if (got && (flag & OSAL_EVENT_FLAG_CLEAR))
+    {
+        event->bits &= ~got;
+    }
+
+    osal_leave_critical_section(cs);
+
+    return got;
+}
+
+//-----------------------------------------------------------------------------
+// Message Queue
+//-----------------------------------------------------------------------------
+
+static int mq_is_ready(psched_obj_t *obj)
+{
+    psched_mq_t *mq = (psched_mq_t *)obj;
+
+    return (mq->count > 0) && !(mq->loan & PSCHED_MQ_LOAN_RX);
+}
+
+/*
+ * psched_wait_level(): 可以取走的消息数
+ */
+static uint32_t mq_level(psched_obj_t *obj)
+{
+    psched_mq_t *mq = (psched_mq_t *)obj;
+
+    return (mq->loan & PSCHED_MQ_LOAN_RX) ? 0 : mq->count;
+}
+
+static inline void *mq_slot(psched_mq_t *mq, uint32_t index)
+{
+    return mq->buf + (size_t)index * mq->item_size;
+}
+
+psched_mq_t *psched_mq_create(const char *name, uint32_t opt,
+                              uint32_t item_size, uint32_t max_msgs)
+{
+    psched_mq_t *mq;
+
+    if ((item_size == 0) || (max_msgs == 0))
+    {
+        LOG_ERR(STR_OSAL_CREATE_MQ_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    mq = (psched_mq_t *)psched_obj_alloc(sizeof(psched_mq_t));
+    if (mq)
+    {
+        mq->buf = (unsigned char *)psched_obj_alloc((size_t)item_size * max_msgs);
+    }
+
+    if (!mq || !mq->buf)
+    {
+        psched_obj_free(mq);
+        LOG_ERR(STR_OSAL_CREATE_MQ_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    psched_obj_init(&mq->obj, PSCHED_OBJ_MQ, name, opt, mq_is_ready);
+    mq->obj.level = mq_level;
+
+    mq->item_size = item_size;
+    mq->max_msgs  = max_msgs;
+    mq->count     = 0;
+    mq->head      = 0;
+    mq->tail      = 0;
+    mq->loan      = 0;
+
+    return mq;
+}
+
+int psched_mq_valid(const void *mq)
+{
+    return psched_obj_valid(mq) && (((const psched_mq_t *)mq)->obj.is_ready == mq_is_ready);
+}
+
+void psched_mq_delete(psched_mq_t *mq)
+{
+    if (mq)
+    {
+        psched_obj_cleanup(&mq->obj);
+        psched_obj_free(mq->buf);
+        psched_obj_free(mq);
+    }
+}
+
+int psched_mq_send(psched_mq_t *mq, const void *msg, int size)
+{
+    size_t flag;
+
+    if (!mq || !msg || (size <= 0) || ((uint32_t)size > mq->item_size))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if ((mq->count >= mq->max_msgs) || (mq->loan & PSCHED_MQ_LOAN_TX))
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_TIMEOUT;
+    }
+
+    memcpy(mq_slot(mq, mq->tail), msg, size);
+    if (++mq->tail == mq->max_msgs)
+    {
+        mq->tail = 0;
+    }
+    mq->count++;
+
+    if (mq_is_ready(&mq->obj))
+    {
+        psched_obj_wake(&mq->obj, 1);
+    }
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+int psched_mq_receive(psched_mq_t *mq, void *msg, int size)
+{
+    size_t flag;
+
+    if (!mq || !msg || (size <= 0))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    if ((uint32_t)size > mq->item_size)
+    {
+        size = (int)mq->item_size;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if ((mq->count == 0) || (mq->loan & PSCHED_MQ_LOAN_RX))
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_TIMEOUT;
+    }
+
+    memcpy(msg, mq_slot(mq, mq->head), size);
+    if (++mq->head == mq->max_msgs)
+    {
+        mq->head = 0;
+    }
+    mq->count--;
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+int psched_mq_loan(psched_mq_t *mq, void **ptr)
+{
+    size_t flag;
+
+    if (!mq || !ptr)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if ((mq->count >= mq->max_msgs) || (mq->loan & PSCHED_MQ_LOAN_TX))
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_TIMEOUT;
+    }
+
+    mq->loan |= PSCHED_MQ_LOAN_TX;
+    *ptr = mq_slot(mq, mq->tail);
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+int psched_mq_commit(psched_mq_t *mq, void *ptr)
+{
+    size_t flag;
+
+    if (!mq)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (!(mq->loan & PSCHED_MQ_LOAN_TX) || (ptr != mq_slot(mq, mq->tail)))
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_INVAL;
+    }
+
+    mq->loan &= ~PSCHED_MQ_LOAN_TX;
+    if (++mq->tail == mq->max_msgs)
+    {
+        mq->tail = 0;
+    }
+    mq->count++;
+
+    if (mq_is_ready(&mq->obj))
+    {
+        psched_obj_wake(&mq->obj, 1);
+    }
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+int psched_mq_receive_ref(psched_mq_t *mq, void **ptr)
+{
+    size_t flag;
+
+    if (!mq || !ptr)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if ((mq->count == 0) || (mq->loan & PSCHED_MQ_LOAN_RX))
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_TIMEOUT;
+    }
+
+    /*
+     * 消息留在队列中, 释放前不会被覆盖
+     */
+    mq->loan |= PSCHED_MQ_LOAN_RX;
+    *ptr = mq_slot(mq, mq->head);
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+int psched_mq_release(psched_mq_t *mq, void *ptr)
+{
+    size_t flag;
+
+    if (!mq)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (!(mq->loan & PSCHED_MQ_LOAN_RX) || (ptr != mq_slot(mq, mq->head)))
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_INVAL;
+    }
+
+    mq->loan &= ~PSCHED_MQ_LOAN_RX;
+    if (++mq->head == mq->max_msgs)
+    {
+        mq->head = 0;
+    }
+    mq->count--;
+
+    /*
+     * 借用期间等待的接收者
+     */
+    if (mq_is_ready(&mq->obj))
+    {
+        psched_obj_wake(&mq->obj, 1);
+    }
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+uint32_t psched_mq_count(psched_mq_t *mq)
+{
+    return mq ? mq->count : 0;
+}
+
+int psched_mq_flush(psched_mq_t *mq)
+{
+    size_t flag;
+
+    if (!mq)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    /*
+     * 借出的空位和消息还在使用
+     */
+    if (mq->loan)
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_INVAL;
+    }
+
+    mq->count = 0;
+    mq->head  = 0;
+    mq->tail  = 0;
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+int psched_mq_send_n(psched_mq_t *mq, const void *msgs, int n)
+{
+    const unsigned char *p = (const unsigned char *)msgs;
+    uint32_t count, k;
+    size_t flag;
+
+    if (!mq || !msgs || (n <= 0))
+    {
+        return 0;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (mq->loan & PSCHED_MQ_LOAN_TX)
+    {
+        osal_leave_critical_section(flag);
+        return 0;
+    }
+
+    count = mq->max_msgs - mq->count;
+    if (count > (uint32_t)n)
+    {
+        count = (uint32_t)n;
+    }
+
+    /*
+     * 到结尾分两段复制
+     */
+    k = mq->max_msgs - mq->tail;
+    if (k > count)
+    {
+        k = count;
+    }
+
+    memcpy(mq_slot(mq, mq->tail), p, (size_t)k * mq->item_size);
+    memcpy(mq->buf, p + (size_t)k * mq->item_size, (size_t)(count - k) * mq->item_size);
+
+    mq->tail += count;
+    if (mq->tail >= mq->max_msgs)
+    {
+        mq->tail -= mq->max_msgs;
+    }
+    mq->count += count;
+
+    if ((count > 0) && mq_is_ready(&mq->obj))
+    {
+        psched_obj_wake(&mq->obj, 1);
+    }
+
+    osal_leave_critical_section(flag);
+
+    return (int)count;
+}
+
+int psched_mq_receive_n(psched_mq_t *mq, void *buf, int max, int min)
+{
+    unsigned char *p = (unsigned char *)buf;
+    uint32_t count, k;
+    size_t flag;
+
+    if (!mq || !buf || (max <= 0))
+    {
+        return 0;
+    }
+
+    if (min < 1)
+    {
+        min = 1;
+    }
+    else if ((uint32_t)min > mq->max_msgs)
+    {
+        min = (int)mq->max_msgs;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if ((mq->count < (uint32_t)min) || (mq->loan & PSCHED_MQ_LOAN_RX))
+    {
+        osal_leave_critical_section(flag);
+        return 0;
+    }
+
+    count = mq->count;
+    if (count > (uint32_t)max)
+    {
+        count = (uint32_t)max;
+    }
+
+    k = mq->max_msgs - mq->head;
+    if (k > count)
+    {
+        k = count;
+    }
+
+    memcpy(p, mq_slot(mq, mq->head), (size_t)k * mq->item_size);
+    memcpy(p + (size_t)k * mq->item_size, mq->buf, (size_t)(count - k) * mq->item_size);
+
+    mq->head += count;
+    if (mq->head >= mq->max_msgs)
+    {
+        mq->head -= mq->max_msgs;
+    }
+    mq->count -= count;
+
+    osal_leave_critical_section(flag);
+
+    return (int)count;
+}
+
+//-----------------------------------------------------------------------------
+// Variable Length Message Queue
+//-----------------------------------------------------------------------------
+
+static int vmq_is_ready(psched_obj_t *obj)
+{
+    return ((psched_vmq_t *)obj)->count > 0;
+}
+
+/*
+ * 环形缓冲区的读写, 在结尾处分两段
+ */
+static void vmq_write(psched_vmq_t *vmq, const void *data, uint32_t size)
+{
+    uint32_t n = vmq->buf_size - vmq->tail;
+
+    if (n > size)
+    {
+        n = size;
+    }
+
+    memcpy(vmq->buf + vmq->tail, data, n);
+    memcpy(vmq->buf, (const unsigned char *)data + n, size - n);
+
+    vmq->tail += size;
+    if (vmq->tail >= vmq->buf_size)
+    {
+        vmq->tail -= vmq->buf_size;
+    }
+}
+
+static void vmq_read(psched_vmq_t *vmq, uint32_t pos, void *data, uint32_t size)
+{
+    uint32_t n = vmq->buf_size - pos;
+
+    if (n > size)
+    {
+        n = size;
+    }
+
+    memcpy(data, vmq->buf + pos, n);
+    memcpy((unsigned char *)data + n, vmq->buf, size - n);
+}
+
+static inline uint32_t vmq_head_size(psched_vmq_t *vmq)
+{
+    uint16_t len;
+
+    vmq_read(vmq, vmq->head, &len, PSCHED_VMQ_HDR_SIZE);
+
+    return len;
+}
+
+psched_vmq_t *psched_vmq_create(const char *name, uint32_t opt,
+                                uint32_t buf_size, uint32_t msg_max)
+{
+    psched_vmq_t *vmq;
+
+    if (msg_max == 0)
+    {
+        msg_max = buf_size > PSCHED_VMQ_HDR_SIZE ? buf_size - PSCHED_VMQ_HDR_SIZE : 0;
+    }
+
+    if ((msg_max == 0) || (msg_max > PSCHED_VMQ_MSG_MAX) ||
+        (msg_max + PSCHED_VMQ_HDR_SIZE > buf_size))
+    {
+        LOG_ERR(STR_OSAL_CREATE_MQ_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    vmq = (psched_vmq_t *)psched_obj_alloc(sizeof(psched_vmq_t));
+    if (vmq)
+    {
+        vmq->buf = (unsigned char *)psched_obj_alloc(buf_size);
+    }
+
+    if (!vmq || !vmq->buf)
+    {
+        psched_obj_free(vmq);
+        LOG_ERR(STR_OSAL_CREATE_MQ_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    psched_obj_init(&vmq->obj, PSCHED_OBJ_MQ, name, opt, vmq_is_ready);
+
+    vmq->buf_size = buf_size;
+    vmq->msg_max  = msg_max;
+    vmq->used     = 0;
+    vmq->count    = 0;
+    vmq->head     = 0;
+    vmq->tail     = 0;
+    vmq->used_max = 0;
+
+    return vmq;
+}
+
+void psched_vmq_delete(psched_vmq_t *vmq)
+{
+    if (vmq)
+    {
+        psched_obj_cleanup(&vmq->obj);
+        psched_obj_free(vmq->buf);
+        psched_obj_free(vmq);
+    }
+}
+
+int psched_vmq_send(psched_vmq_t *vmq, const void *msg, int size)
+{
+    uint16_t len = (uint16_t)size;
+    size_t flag;
+
+    if (!vmq || !msg || (size <= 0) || ((uint32_t)size > vmq->msg_max))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (vmq->used + PSCHED_VMQ_HDR_SIZE + size > vmq->buf_size)
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_TIMEOUT;
+    }
+
+    vmq_write(vmq, &len, PSCHED_VMQ_HDR_SIZE);
+    vmq_write(vmq, msg, size);
+
+    vmq->used += PSCHED_VMQ_HDR_SIZE + size;
+    vmq->count++;
+    if (vmq->used > vmq->used_max)
+    {
+        vmq->used_max = vmq->used;
+    }
+
+    psched_obj_wake(&vmq->obj, 1);
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+int psched_vmq_receive(psched_vmq_t *vmq, void *msg, int size)
+{
+    uint32_t len, pos;
+    size_t flag;
+
+    if (!vmq || !msg || (size <= 0))
+    {
+        return 0;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (vmq->count == 0)
+    {
+        osal_leave_critical_section(flag);
+        return 0;
+    }
+
+    len = vmq_head_size(vmq);
+    if (len > (uint32_t)size)
+    {
+        osal_leave_critical_section(flag);
+        return -(int)len;                       /* 缓冲区不够, 消息留在队列中 */
+    }
+
+    pos = vmq->head + PSCHED_VMQ_HDR_SIZE;
+    if (pos >= vmq->buf_size)
+    {
+        pos -= vmq->buf_size;
+    }
+
+    vmq_read(vmq, pos, msg, len);
+
+    vmq->head = pos + len;
+    if (vmq->head >= vmq->buf_size)
+    {
+        vmq->head -= vmq->buf_size;
+    }
+    vmq->used -= PSCHED_VMQ_HDR_SIZE + len;
+    vmq->count--;
+
+    /*
+     * 队列空时回到开头, 以后的消息少分段
+     */
+    if (vmq->count == 0)
+    {
+        vmq->head = 0;
+        vmq->tail = 0;
+    }
+
+    osal_leave_critical_section(flag);
+
+    return (int)len;
+}
+
+int psched_vmq_peek_size(psched_vmq_t *vmq)
+{
+    size_t flag;
+    int len = 0;
+
+    if (!vmq)
+    {
+        return 0;
+    }
+
+    flag = osal_enter_critical_section();
+    if (vmq->count > 0)
+    {
+        len = (int)vmq_head_size(vmq);
+    }
+    osal_leave_critical_section(flag);
+
+    return len;
+}
+
+uint32_t psched_vmq_count(psched_vmq_t *vmq)
+{
+    return vmq ? vmq->count : 0;
+}
+
+int psched_vmq_flush(psched_vmq_t *vmq)
+{
+    size_t flag;
+
+    if (!vmq)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+    vmq->used  = 0;
+    vmq->count = 0;
+    vmq->head  = 0;
+    vmq->tail  = 0;
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Mailbox
+//-----------------------------------------------------------------------------
+
+#if __loongarch64
+#define MBOX_BARRIER()      __asm__ __volatile__("dbar 0" ::: "memory")
+#else
+#define MBOX_BARRIER()      __sync_synchronize()
+#endif
+
+/*
+ * 接收时发送者一直在写 (接收在 isr 中), 重试次数
+ */
+#define MBOX_READ_RETRY     4
+
+static int mbox_is_ready(psched_obj_t *obj)
+{
+    psched_mbox_t *mbox = (psched_mbox_t *)obj;
+    uint32_t seq = mbox->seq;
+
+    return !(seq & 1) && ((seq >> 1) != mbox->read_seq);
+}
+
+psched_mbox_t *psched_mbox_create(const char *name, uint32_t opt, uint32_t item_size)
+{
+    psched_mbox_t *mbox;
+
+    if (item_size == 0)
+    {
+        LOG_ERR(STR_OSAL_CREATE_MQ_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    mbox = (psched_mbox_t *)psched_obj_alloc(sizeof(psched_mbox_t));
+    if (mbox)
+    {
+        mbox->buf = (unsigned char *)psched_obj_alloc(item_size);
+    }
+
+    if (!mbox || !mbox->buf)
+    {
+        psched_obj_free(mbox);
+        LOG_ERR(STR_OSAL_CREATE_MQ_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    psched_obj_init(&mbox->obj, PSCHED_OBJ_MQ, name, opt, mbox_is_ready);
+
+    mbox->item_size = item_size;
+    mbox->seq       = 0;
+    mbox->size      = 0;
+    mbox->read_seq  = 0;
+    mbox->overrun   = 0;
+
+    return mbox;
+}
+
+void psched_mbox_delete(psched_mbox_t *mbox)
+{
+    if (mbox)
+    {
+        psched_obj_cleanup(&mbox->obj);
+        psched_obj_free(mbox->buf);
+        psched_obj_free(mbox);
+    }
+}
+
+int psched_mbox_send(psched_mbox_t *mbox, const void *msg, int size)
+{
+    uint32_t seq;
+    size_t flag;
+
+    if (!mbox || !msg || (size <= 0) || ((uint32_t)size > mbox->item_size))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    seq = mbox->seq;
+
+    /*
+     * 上一个消息还没有接收
+     */
+    if ((seq >> 1) && ((seq >> 1) != mbox->read_seq))
+    {
+        mbox->overrun++;
+    }
+
+    /*
+     * 序号为奇数时写入, 接收者读到奇数或者前后序号不同时重读
+     */
+    mbox->seq = seq + 1;
+    MBOX_BARRIER();
+
+    memcpy(mbox->buf, msg, size);
+    mbox->size = size;
+
+    MBOX_BARRIER();
+    mbox->seq = seq + 2;
+
+    /*
+     * 等待的任务在临界区中检查并加入等待队列, 这里没有任务等待时不用唤醒
+     */
+    if (!TAILQ_EMPTY(&mbox->obj.waitq))
+    {
+        flag = osal_enter_critical_section();
+        psched_obj_wake(&mbox->obj, 1);
+        osal_leave_critical_section(flag);
+    }
+
+    return OSAL_ERR_OK;
+}
+
+int psched_mbox_receive(psched_mbox_t *mbox, void *msg, int size, uint32_t *seq)
+{
+    uint32_t begin, n;
+    int i;
+
+    if (!mbox || !msg || (size <= 0))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    for (i=0; i<MBOX_READ_RETRY; i++)
+    {
+        begin = mbox->seq;
+        MBOX_BARRIER();
+
+        if (begin & 1)
+        {
+            continue;
+        }
+
+        if ((begin >> 1) == mbox->read_seq)
+        {
+            return OSAL_ERR_TIMEOUT;            /* 没有新消息 */
+        }
+
+        n = mbox->size;
+        if (n > (uint32_t)size)
+        {
+            n = (uint32_t)size;
+        }
+
+        memcpy(msg, mbox->buf, n);
+
+        MBOX_BARRIER();
+        if (mbox->seq == begin)
+        {
+            mbox->read_seq = begin >> 1;
+            if (seq)
+            {
+                *seq = begin >> 1;
+            }
+
+            return OSAL_ERR_OK;
+        }
+    }
+
+    return OSAL_ERR_TIMEOUT;
+}
+
+void psched_mbox_flush(psched_mbox_t *mbox)
+{
+    if (mbox)
+    {
+        mbox->read_seq = mbox->seq >> 1;
+    }
+}
+
+/*
+ * @@ END
+ */
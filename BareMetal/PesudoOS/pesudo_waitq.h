@@ -0,0 +1,272 @@
+/*
+ * pesudo_waitq.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Objects of pesudo_sched: semaphore, event, message queue, variable length
+ * message queue and mailbox.
+ *
+ * This is the 0.3 design of PesudoOS: every object has a list of the waiting
+ * tasks, so a signal only wake its own waiters, in O(waiters), no scan of all
+ * tasks. A task wait any of some objects by psched_wait_any().
+ *
+ * The operations never block, they can be called in isr. A task waits by
+ * psched_wait_any() and takes the object when it is run again:
+ *
+ *     static void task(void *arg)
+ *     {
+ *         while (psched_mq_receive(mq, &msg, sizeof(msg)) == OSAL_ERR_OK)
+ *             ...
+ *         if (psched_event_receive(ev, CMD_BITS, OSAL_EVENT_FLAG_OR | OSAL_EVENT_FLAG_CLEAR))
+ *             ...
+ *         psched_wait_any(objs, 2, 100);
+ *     }
+ */
+
+#ifndef _PESUDO_WAITQ_H
+#define _PESUDO_WAITQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "osal.h"
+#include "pesudo_sched.h"
+
+//-----------------------------------------------------------------------------
+// Semaphore
+//-----------------------------------------------------------------------------
+
+typedef struct psched_sem
+{
+    psched_obj_t obj;
+    uint32_t     count;
+} psched_sem_t;
+
+psched_sem_t *psched_sem_create(const char *name, uint32_t opt, uint32_t initial_count);
+void psched_sem_delete(psched_sem_t *sem);
+
+/*
+ * OSAL_ERR_OK: obtained, OSAL_ERR_TIMEOUT: count is 0
+ */
+int psched_sem_obtain(psched_sem_t *sem);
+int psched_sem_release(psched_sem_t *sem);
+
+//-----------------------------------------------------------------------------
+// Event
+//-----------------------------------------------------------------------------
+
+/*
+ * ready when any bit is set, all waiters are waked
+ */
+typedef struct psched_event
+{
+    psched_obj_t obj;
+    uint32_t     bits;
+} psched_event_t;
+
+psched_event_t *psched_event_create(const char *name, uint32_t opt);
+void psched_event_delete(psched_event_t *event);
+
+int psched_event_send(psched_event_t *event, uint32_t bits);
+
+/*
+ * flag: OSAL_EVENT_FLAG_AND/OR/CLEAR, return the received bits, 0 if not
+ */
+uint32_t psched_event_receive(psched_event_t *event, uint32_t bits, uint32_t flag);
+
+//-----------------------------------------------------------------------------
+// Message Queue
+//-----------------------------------------------------------------------------
+
+typedef struct psched_mq
+{
+    psched_obj_t   obj;
+    uint32_t       item_size;                   /* 消息大小 */
+    uint32_t       max_msgs;                    /* 消息个数 */
+    uint32_t       count;                       /* 已有消息 */
+    uint32_t       head;                        /* 读位置 */
+    uint32_t       tail;                        /* 写位置 */
+    uint32_t       loan;                        /* PSCHED_MQ_LOAN_* */
+    unsigned char *buf;
+} psched_mq_t;
+
+#define PSCHED_MQ_LOAN_TX       0x0001          /* tail 的空位借给发送者 */
+#define PSCHED_MQ_LOAN_RX       0x0002          /* head 的消息借给接收者 */
+
+psched_mq_t *psched_mq_create(const char *name, uint32_t opt,
+                              uint32_t item_size, uint32_t max_msgs);
+void psched_mq_delete(psched_mq_t *mq);
+
+/*
+ * OSAL_ERR_OK, OSAL_ERR_TIMEOUT: full, OSAL_ERR_INVAL: size too large
+ */
+int psched_mq_send(psched_mq_t *mq, const void *msg, int size);
+
+/*
+ * OSAL_ERR_OK, OSAL_ERR_TIMEOUT: empty. size may be less than item_size
+ */
+int psched_mq_receive(psched_mq_t *mq, void *msg, int size);
+
+/*
+ * Zero copy: the sender writes in the free slot and commits it, the receiver
+ * reads the message in its slot and releases it:
+ *
+ *     if (psched_mq_loan(mq, &p) == OSAL_ERR_OK)        // OSAL_ERR_TIMEOUT: full
+ *     {
+ *         fill(p);                                       // item_size bytes
+ *         psched_mq_commit(mq, p);
+ *     }
+ *
+ *     if (psched_mq_receive_ref(mq, &p) == OSAL_ERR_OK) // OSAL_ERR_TIMEOUT: empty
+ *     {
+ *         use(p);
+ *         psched_mq_release(mq, p);
+ *     }
+ *
+ * One loan for each side: while a slot is loaned, send/loan return full,
+ * receive/receive_ref return empty. A loan may be kept across task runs, the
+ * message stays in the queue until released.
+ */
+int psched_mq_loan(psched_mq_t *mq, void **ptr);
+int psched_mq_commit(psched_mq_t *mq, void *ptr);
+int psched_mq_receive_ref(psched_mq_t *mq, void **ptr);
+int psched_mq_release(psched_mq_t *mq, void *ptr);
+
+uint32_t psched_mq_count(psched_mq_t *mq);
+int psched_mq_flush(psched_mq_t *mq);
+
+/*
+ * the handle is a psched_mq, not a vmq, mailbox or a queue of libbsp
+ */
+int psched_mq_valid(const void *mq);
+
+/*
+ * Batch: n messages of item_size bytes one after another in msgs/buf, copied
+ * in one critical section, the receiver is waked once.
+ *
+ * psched_mq_send_n() sends as many as there is room, return the count sent.
+ * psched_mq_receive_n() receives up to max if there are at least min (at most
+ * max_msgs), return the count received, 0 if less than min.
+ *
+ * A receiver of bursts waits psched_wait_level(mq, min, timeout), it is waked
+ * when min messages are in, the other receivers of the queue still at 1.
+ */
+int psched_mq_send_n(psched_mq_t *mq, const void *msgs, int n);
+int psched_mq_receive_n(psched_mq_t *mq, void *buf, int max, int min);
+
+//-----------------------------------------------------------------------------
+// Variable Length Message Queue
+//-----------------------------------------------------------------------------
+
+/*
+ * The messages are records of a byte ring: 2 bytes length and the bytes of
+ * the message, a record may wrap at the end of the ring. So a message takes
+ * its own size + 2, no slot of the largest size:
+ *
+ *     vmq = psched_vmq_create("cmd", 0, 256, 64);   // 256 bytes ring, <= 64
+ *
+ *     psched_vmq_send(vmq, msg, len);                // OSAL_ERR_TIMEOUT: no room
+ *     len = psched_vmq_receive(vmq, buf, sizeof(buf));
+ */
+#define PSCHED_VMQ_HDR_SIZE     2
+#define PSCHED_VMQ_MSG_MAX      0xFFFF
+
+typedef struct psched_vmq
+{
+    psched_obj_t   obj;
+    uint32_t       buf_size;                    /* 环形缓冲区字节数 */
+    uint32_t       msg_max;                     /* 最大消息 */
+    uint32_t       used;                        /* 已用字节, 含长度 */
+    uint32_t       count;                       /* 已有消息 */
+    uint32_t       head;                        /* 读位置 */
+    uint32_t       tail;                        /* 写位置 */
+    uint32_t       used_max;                    /* 最多使用的字节 */
+    unsigned char *buf;
+} psched_vmq_t;
+
+/*
+ * msg_max: largest message, 0 is buf_size - PSCHED_VMQ_HDR_SIZE
+ */
+psched_vmq_t *psched_vmq_create(const char *name, uint32_t opt,
+                                uint32_t buf_size, uint32_t msg_max);
+void psched_vmq_delete(psched_vmq_t *vmq);
+
+/*
+ * OSAL_ERR_OK, OSAL_ERR_TIMEOUT: no room, OSAL_ERR_INVAL: size is 0 or larger
+ * than msg_max
+ */
+int psched_vmq_send(psched_vmq_t *vmq, const void *msg, int size);
+
+/*
+ * return the length of the message, 0 if empty. If size is less than the
+ * message it is not taken, return -(length).
+ */
+int psched_vmq_receive(psched_vmq_t *vmq, void *msg, int size);
+
+/*
+ * length of the next message, 0 if empty
+ */
+int psched_vmq_peek_size(psched_vmq_t *vmq);
+
+uint32_t psched_vmq_count(psched_vmq_t *vmq);
+int psched_vmq_flush(psched_vmq_t *vmq);
+
+//-----------------------------------------------------------------------------
+// Mailbox
+//-----------------------------------------------------------------------------
+
+/*
+ * Latest value: one message, a send overwrites it. The send doesn't lock
+ * (seqlock), it can be called in isr or task but by one sender only. The
+ * receiver copies the newest message, and copies again if a send came in
+ * the middle; it gets OSAL_ERR_TIMEOUT if no message newer than the last
+ * received one. Ready to wait when there is a newer message.
+ *
+ * seq is the count of sends, the number of the message. overrun is the count
+ * of messages overwritten before received.
+ */
+typedef struct psched_mbox
+{
+    psched_obj_t      obj;
+    uint32_t          item_size;
+    volatile uint32_t seq;                      /* 发送次数 x 2, 奇数: 正在写 */
+    volatile uint32_t size;                     /* 消息大小 */
+    volatile uint32_t read_seq;                 /* 最后接收的消息序号 */
+    volatile uint32_t overrun;                  /* 未接收就被覆盖的消息 */
+    unsigned char    *buf;
+} psched_mbox_t;
+
+psched_mbox_t *psched_mbox_create(const char *name, uint32_t opt, uint32_t item_size);
+void psched_mbox_delete(psched_mbox_t *mbox);
+
+/*
+ * OSAL_ERR_OK, OSAL_ERR_INVAL: size too large. Never full
+ */
+int psched_mbox_send(psched_mbox_t *mbox, const void *msg, int size);
+
+/*
+ * OSAL_ERR_OK: msg is the newest, *seq is its number (seq may be NULL)
+ * OSAL_ERR_TIMEOUT: no new message, or the sender is writing (in isr)
+ */
+int psched_mbox_receive(psched_mbox_t *mbox, void *msg, int size, uint32_t *seq);
+
+/*
+ * the current message is received
+ */
+void psched_mbox_flush(psched_mbox_t *mbox);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_WAITQ_H
+
+/*
+ * @@ END
+ */
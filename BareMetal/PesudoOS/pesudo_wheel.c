@@ -0,0 +1,284 @@
+/*
+ * pesudo_wheel.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include <stddef.h>
+
+#include "pesudo_wheel.h"
+
+#define LEVEL_SHIFT(level)      ((level) * PWHEEL_BITS)
+#define LEVEL_RANGE(level)      ((uint64_t)1 << LEVEL_SHIFT((level) + 1))
+
+//-----------------------------------------------------------------------------
+
+void pwheel_init(pwheel_t *wheel, uint64_t now)
+{
+    int i, j;
+
+    for (i=0; i<PWHEEL_LEVELS; i++)
+    {
+        for (j=0; j<PWHEEL_SLOTS; j++)
+        {
+            TAILQ_INIT(&wheel->slot[i][j]);
+        }
+
+        wheel->bitmap[i] = 0;
+    }
+
+    TAILQ_INIT(&wheel->expired);
+
+    wheel->cur   = now;
+    wheel->count = 0;
+}
+
+void pwheel_timer_init(pwheel_timer_t *timer, pwheel_func_t func, void *arg)
+{
+    timer->expires = 0;
+    timer->func    = func;
+    timer->arg     = arg;
+    timer->head    = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+static void wheel_insert(pwheel_t *wheel, pwheel_timer_t *timer)
+{
+    uint64_t expires = timer->expires;
+    int64_t  delta = (int64_t)(expires - wheel->cur);
+    int level, index;
+
+    /*
+     * 已经到期的放到当前 tick
+     */
+    if (delta < 0)
+    {
+        expires = wheel->cur;
+        delta = 0;
+    }
+
+    for (level=0; level<PWHEEL_LEVELS-1; level++)
+    {
+        if ((uint64_t)delta < LEVEL_RANGE(level))
+        {
+            break;
+        }
+    }
+
+    /*
+     * 超出范围的放到最后一个 slot, 转到时重新放置
+     */
+    if ((uint64_t)delta >= LEVEL_RANGE(level))
+    {
+        expires = wheel->cur + LEVEL_RANGE(level) - 1;
+    }
+
+    index = (int)((expires >> LEVEL_SHIFT(level)) & PWHEEL_MASK);
+
+    timer->head = &wheel->slot[level][index];
+    TAILQ_INSERT_TAIL(timer->head, timer, node);
+    wheel->bitmap[level] |= (uint64_t)1 << index;
+}
+
+static void wheel_remove(pwheel_t *wheel, pwheel_timer_t *timer)
+{
+    struct pwheel_list *head = timer->head;
+    int pos;
+
+    TAILQ_REMOVE(head, timer, node);
+    timer->head = NULL;
+
+    if ((head != &wheel->expired) && TAILQ_EMPTY(head))
+    {
+        pos = (int)(head - &wheel->slot[0][0]);
+        wheel->bitmap[pos / PWHEEL_SLOTS] &= ~((uint64_t)1 << (pos % PWHEEL_SLOTS));
+    }
+}
+
+void pwheel_add(pwheel_t *wheel, pwheel_timer_t *timer, uint64_t expires)
+{
+    if (timer->head)
+    {
+        wheel_remove(wheel, timer);
+    }
+    else
+    {
+        wheel->count++;
+    }
+
+    timer->expires = expires;
+    wheel_insert(wheel, timer);
+}
+
+void pwheel_del(pwheel_t *wheel, pwheel_timer_t *timer)
+{
+    if (timer->head)
+    {
+        wheel_remove(wheel, timer);
+        wheel->count--;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/*
+ * 转到 slot, 其中的定时器放到低一级
+ */
+static void wheel_cascade(pwheel_t *wheel, int level)
+{
+    int index = (int)((wheel->cur >> LEVEL_SHIFT(level)) & PWHEEL_MASK);
+    struct pwheel_list *head = &wheel->slot[level][index];
+    pwheel_timer_t *timer;
+
+    /*
+     * 上一级先转到, 才能放到本级
+     */
+    if ((index == 0) && (level < PWHEEL_LEVELS - 1))
+    {
+        wheel_cascade(wheel, level + 1);
+    }
+
+    while ((timer = TAILQ_FIRST(head)) != NULL)
+    {
+        TAILQ_REMOVE(head, timer, node);
+        wheel_insert(wheel, timer);
+    }
+
+    wheel->bitmap[level] &= ~((uint64_t)1 << index);
+}
+
+static inline uint64_t rotate_right(uint64_t bits, int n)
+{
+    return n ? (bits >> n) | (bits << (64 - n)) : bits;
+}
+
+int pwheel_next_expiry(pwheel_t *wheel, uint64_t *expires)
+{
+    uint64_t tick, best = 0;
+    int level, index, first, k, found = 0;
+
+    if (wheel->count == 0)
+    {
+        return 0;
+    }
+
+    for (level=0; level<PWHEEL_LEVELS; level++)
+    {
+        if (!wheel->bitmap[level])
+        {
+            continue;
+        }
+
+        /*
+         * 从当前 slot 开始; 高级的当前 slot 若已转过, 其中是下一圈的,
+         * 从下一个 slot 开始
+         */
+        first = 0;
+        if ((level > 0) && (wheel->cur & (LEVEL_RANGE(level - 1) - 1)))
+        {
+            first = 1;
+        }
+
+        index = (int)(((wheel->cur >> LEVEL_SHIFT(level)) + first) & PWHEEL_MASK);
+        k = __builtin_ctzll(rotate_right(wheel->bitmap[level], index));
+
+        if (level == 0)
+        {
+            tick = wheel->cur + k;
+        }
+        else
+        {
+            tick = ((wheel->cur >> LEVEL_SHIFT(level)) + first + k) << LEVEL_SHIFT(level);
+        }
+
+        if (!found || (tick < best))
+        {
+            best  = tick;
+            found = 1;
+        }
+
+    }
+
+    *expires = best;
+    return found;
+}
+
+int pwheel_advance(pwheel_t *wheel, uint64_t now)
+{
+    pwheel_timer_t *timer;
+    uint64_t bits, next;
+    int index, count = 0;
+
+    while ((int64_t)(now - wheel->cur) >= 0)
+    {
+        if (wheel->count == 0)
+        {
+            wheel->cur = now + 1;
+            break;
+        }
+
+        index = (int)(wheel->cur & PWHEEL_MASK);
+
+        if (index == 0)
+        {
+            wheel_cascade(wheel, 1);
+        }
+
+        /*
+         * 跳过空的 slot, 到下一个不空的 slot 或下一圈
+         */
+        bits = wheel->bitmap[0] & (~(uint64_t)0 << index);
+        if (!(bits & ((uint64_t)1 << index)))
+        {
+            if (bits)
+                next = (wheel->cur & ~(uint64_t)PWHEEL_MASK) + __builtin_ctzll(bits);
+            else
+                next = (wheel->cur | PWHEEL_MASK) + 1;
+
+            if ((int64_t)(next - now) > 0)
+            {
+                wheel->cur = now + 1;
+                break;
+            }
+
+            wheel->cur = next;
+            continue;
+        }
+
+        /*
+         * 本 tick 到期的定时器
+         */
+        while ((timer = TAILQ_FIRST(&wheel->slot[0][index])) != NULL)
+        {
+            TAILQ_REMOVE(&wheel->slot[0][index], timer, node);
+            TAILQ_INSERT_TAIL(&wheel->expired, timer, node);
+            timer->head = &wheel->expired;
+        }
+
+        wheel->bitmap[0] &= ~((uint64_t)1 << index);
+        wheel->cur++;
+
+        /*
+         * 回调中加入的到期定时器放到下一个 tick, 不会在这里循环
+         */
+        while ((timer = TAILQ_FIRST(&wheel->expired)) != NULL)
+        {
+            wheel_remove(wheel, timer);
+            wheel->count--;
+            count++;
+
+            if (timer->func)
+            {
+                timer->func(timer, timer->arg);
+            }
+        }
+    }
+
+    return count;
+}
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,102 @@
+/*
+ * pesudo_wheel.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Hierarchical timing wheel.
+ *
+ * The unit is one tick (get_clock_ticks(), 1ms). There are PWHEEL_LEVELS
+ * levels of 64 slots, level n slot covers 64^n ticks. A timer is put into the
+ * level its timeout fits, and is moved to lower level when the wheel pass the
+ * slot (cascade). So add/delete is O(1), and pwheel_advance() only touch the
+ * expired timers and the cascaded slots, whatever the count of timers.
+ *
+ * Timeouts longer than 64^PWHEEL_LEVELS ticks (about 4.6 hours) are put at the
+ * last slot and re-cascaded, they expire at the right tick.
+ *
+ * The wheel is not locked, the caller do it.
+ */
+
+#ifndef _PESUDO_WHEEL_H
+#define _PESUDO_WHEEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <sys/queue.h>
+
+//-----------------------------------------------------------------------------
+
+#define PWHEEL_BITS             6
+#define PWHEEL_SLOTS            (1 << PWHEEL_BITS)
+#define PWHEEL_MASK             (PWHEEL_SLOTS - 1)
+#define PWHEEL_LEVELS           4
+
+typedef struct pwheel_timer pwheel_timer_t;
+
+typedef void (*pwheel_func_t)(pwheel_timer_t *timer, void *arg);
+
+TAILQ_HEAD(pwheel_list, pwheel_timer);
+
+struct pwheel_timer
+{
+    uint64_t            expires;                /* 到期 ticks */
+    pwheel_func_t       func;                   /* 到期回调 */
+    void               *arg;
+    struct pwheel_list *head;                   /* 所在 slot, NULL: 未加入 */
+    TAILQ_ENTRY(pwheel_timer) node;
+};
+
+typedef struct pwheel
+{
+    uint64_t            cur;                    /* 下一个要处理的 tick */
+    uint32_t            count;                  /* 定时器个数 */
+    uint64_t            bitmap[PWHEEL_LEVELS];  /* slot 不空 */
+    struct pwheel_list  slot[PWHEEL_LEVELS][PWHEEL_SLOTS];
+    struct pwheel_list  expired;                /* 正在回调 */
+} pwheel_t;
+
+//-----------------------------------------------------------------------------
+
+void pwheel_init(pwheel_t *wheel, uint64_t now);
+
+void pwheel_timer_init(pwheel_timer_t *timer, pwheel_func_t func, void *arg);
+
+/*
+ * add or re-add at the tick expires, already expired tick expire at next
+ * advance
+ */
+void pwheel_add(pwheel_t *wheel, pwheel_timer_t *timer, uint64_t expires);
+void pwheel_del(pwheel_t *wheel, pwheel_timer_t *timer);
+
+static inline int pwheel_pending(const pwheel_timer_t *timer)
+{
+    return timer->head != NULL;
+}
+
+/*
+ * the earliest tick a timer may expire, not later than the real one (the
+ * timers in high level return the start of the slot). 0: no timer.
+ */
+int pwheel_next_expiry(pwheel_t *wheel, uint64_t *expires);
+
+/*
+ * process ticks until now (included), call func of the expired timers.
+ * func can add or delete any timer. Return count of expired.
+ */
+int pwheel_advance(pwheel_t *wheel, uint64_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PESUDO_WHEEL_H
+
+/*
+ * @@ END
+ */
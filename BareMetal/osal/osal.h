@@ -1,189 +1,547 @@
-﻿/*
- * osal.h
- *
- * created: 2025-01-11
- *  author: 
- */
-
-/******************************************************************************
- * Should use clock-tick = 1000 per second, so ms equal tick
- */
-
-#ifndef _OSAL_H
-#define _OSAL_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-#include <stddef.h>
-#include <stdint.h>
-#include <stdbool.h>
-
-#if defined(OS_RTTHREAD)
-#include "rtthread.h"
-#elif defined(OS_FREERTOS)
-#include "FreeRTOS.h"
-#include "task.h"
-#elif defined(OS_UCOS)
-#include "os.h"
-#elif defined(OS_PESUDO)
-#include "pesudoos.h"
-#endif
-
-//-----------------------------------------------------------------------------
-
-extern void printk(const char *fmt, ...);
-extern void delay_ms(int ms);
-extern uint64_t get_clock_ticks(void);
-
-#define LOG_ERR         printk
-
-//-----------------------------------------------------------------------------
-
-#define OSAL_WAIT_FOREVER       0xFFFFFFFF      /* 永久等待 */
-
-#define OSAL_ERR_OK             0
-#define OSAL_ERR_TIMEOUT        1               /* 超时返回 */
-#define OSAL_ERR_INVAL          2               /* 参数错位 */
-
-/*
- * Event MQ Mutex Semphore Common Options
- */
-#define OSAL_OPT_FIFO           0x0001          /* 先进先出 */
-#define OSAL_OPT_LIFO           0x0002          /* 后进先出 */
-#define OSAL_OPT_PRIO           0x0004          /* 按照优先级 */
-#define OSAL_OPT_ALL            0x0008          /* 分发给全部 */
-
-/*
- * Event Receive Flag
- */
-#define OSAL_EVENT_FLAG_AND     0x0001          /* 收到全部事件 */
-#define OSAL_EVENT_FLAG_OR      0x0002          /* 收到任一事件 */
-#define OSAL_EVENT_FLAG_CLEAR   0x0004          /* 事件接收后清除 */
-
-//-----------------------------------------------------------------------------
-
-typedef void*   osal_task_t;
-typedef void*   osal_event_t;
-typedef void*   osal_sem_t;
-typedef void*   osal_mutex_t;
-typedef void*   osal_mq_t;
-typedef void*   osal_timer_t;
-
-//-----------------------------------------------------------------------------
-// Task
-//-----------------------------------------------------------------------------
-
-typedef void (*osal_task_entry_t)(void *arg);
-
-osal_task_t osal_task_create(const char *name,              /* 名称 */
-                             uint32_t stack_size,           /* 堆栈大小 */
-                             uint32_t prio,                 /* 优先级 */
-                             uint32_t slice,                /* 时间片 */
-                             osal_task_entry_t entry,       /* 入口函数 */
-                             void *args);                   /* 函数参数 */
-
-void osal_task_delete(osal_task_t task);
-
-void osal_task_suspend(osal_task_t task);
-void osal_task_resume(osal_task_t task);
-void osal_task_sleep(uint32_t ms);
-void osal_task_sleep_until(uint32_t *prev_ticks, uint32_t inc_ticks);
-
-//-----------------------------------------------------------------------------
-// Event
-//-----------------------------------------------------------------------------
-
-osal_event_t osal_event_create(const char *name, uint32_t opt);
-void osal_event_delete(osal_event_t event);
-
-int  osal_event_send(osal_event_t event, uint32_t bits);
-uint32_t osal_event_receive(osal_event_t event, uint32_t bits,
-                            uint32_t flag, uint32_t timeout_ms);
-void osal_event_set_bits(osal_event_t event, uint32_t bits);
-void osal_event_set_os_opt(osal_event_t event, uint32_t opt);
-
-//-----------------------------------------------------------------------------
-// Semphore
-//-----------------------------------------------------------------------------
-
-osal_sem_t osal_sem_create(const char *name, uint32_t opt, uint32_t initial_count);
-void osal_sem_delete(osal_sem_t sem);
-
-int osal_sem_obtain(osal_sem_t sem, uint32_t timeout);
-int osal_sem_release(osal_sem_t sem);
-void osal_sem_reset(osal_sem_t sem);
-void osal_sem_set_os_opt(osal_sem_t sem, uint32_t opt);
-
-//-----------------------------------------------------------------------------
-// Mutex
-//-----------------------------------------------------------------------------
-
-osal_mutex_t osal_mutex_create(const char *name, uint32_t opt);
-void osal_mutex_delete(osal_mutex_t mutex);
-int osal_mutex_obtain(osal_mutex_t mutex, uint32_t timeout_ms);
-int osal_mutex_release(osal_mutex_t mutex);
-void osal_mutex_set_os_opt(osal_mutex_t mutex, uint32_t opt);
-
-//-----------------------------------------------------------------------------
-// Message Queue
-//-----------------------------------------------------------------------------
-
-osal_mq_t osal_mq_create(const char *name, uint32_t opt,
-                         uint32_t item_size, uint32_t max_msgs);
-void osal_mq_delete(osal_mq_t mq);
-int osal_mq_send(osal_mq_t mq, const void *msg, int size);
-int osal_mq_receive(osal_mq_t mq, void *msg, int size, uint32_t timeout);
-void osal_mq_set_os_opt(osal_mq_t mq, uint32_t opt);
-
-int osal_mq_is_full(osal_mq_t mq);
-int osal_mq_flush(osal_mq_t mq);
-
-//-----------------------------------------------------------------------------
-// Timer
-//-----------------------------------------------------------------------------
-
-osal_timer_t osal_timer_create(const char *name,
-                               osal_task_entry_t handler,
-                               void *argument,
-                               uint32_t timeout_ms,
-                               bool is_period);
-
-void osal_timer_delete(osal_timer_t timer);
-
-void osal_timer_start(osal_timer_t timer, uint32_t timeout_ms);
-void osal_timer_stop(osal_timer_t timer);
-
-//-----------------------------------------------------------------------------
-// Other
-//-----------------------------------------------------------------------------
-
-int osal_is_osrunning(void);        /* return 1 == running */
-
-size_t osal_enter_critical_section(void);
-void osal_leave_critical_section(size_t flag);
-
-void osal_msleep(uint32_t ms);
-
-void *osal_malloc(size_t size);
-void osal_free(void *ptr);
-
-//-----------------------------------------------------------------------------
-// 字符串常量
-//-----------------------------------------------------------------------------
-
-#define STR_OSAL_CREATE_TASK_FAIL   "create osal task %s fail"
-#define STR_OSAL_CREATE_EVENT_FAIL  "create osal event %s fail"
-#define STR_OSAL_CREATE_SEM_FAIL    "create osal semphore %s fail"
-#define STR_OSAL_CREATE_MUTEX_FAIL  "create osal mutex %s fail"
-#define STR_OSAL_CREATE_MQ_FAIL     "create osal message queue %s fail"
-#define STR_OSAL_CREATE_TIMER_FAIL  "create osal timer %s fail"
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif // _OSAL_H
-
-
+﻿/*
+ * osal.h
+ *
+ * created: 2025-01-11
+ *  author: 
+ */
+
+/******************************************************************************
+ * Should use clock-tick = 1000 per second, so ms equal tick
+ */
+
+#ifndef _OSAL_H
+#define _OSAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(OS_RTTHREAD)
+#include "rtthread.h"
+#elif defined(OS_FREERTOS)
+#include "FreeRTOS.h"
+#include "task.h"
+#elif defined(OS_UCOS)
+#include "os.h"
+#elif defined(OS_PESUDO)
+#include "pesudoos.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+extern void printk(const char *fmt, ...);
+extern void delay_ms(int ms);
+extern uint64_t get_clock_ticks(void);
+
+#define LOG_ERR         printk
+
+//-----------------------------------------------------------------------------
+
+#define OSAL_WAIT_FOREVER       0xFFFFFFFF      /* 永久等待 */
+
+#define OSAL_ERR_OK             0
+#define OSAL_ERR_TIMEOUT        1               /* 超时返回 */
+#define OSAL_ERR_INVAL          2               /* 参数错位 */
+
+/*
+ * Event MQ Mutex Semphore Common Options
+ */
+#define OSAL_OPT_FIFO           0x0001          /* 先进先出 */
+#define OSAL_OPT_LIFO           0x0002          /* 后进先出 */
+#define OSAL_OPT_PRIO           0x0004          /* 按照优先级 */
+#define OSAL_OPT_ALL            0x0008          /* 分发给全部 */
+#define OSAL_OPT_OVERWRITE      0x0010          /* MQ: 邮箱, 只保留最新的消息 */
+
+/*
+ * Event Receive Flag
+ */
+#define OSAL_EVENT_FLAG_AND     0x0001          /* 收到全部事件 */
+#define OSAL_EVENT_FLAG_OR      0x0002          /* 收到任一事件 */
+#define OSAL_EVENT_FLAG_CLEAR   0x0004          /* 事件接收后清除 */
+
+//-----------------------------------------------------------------------------
+
+typedef void*   osal_task_t;
+typedef void*   osal_event_t;
+typedef void*   osal_sem_t;
+typedef void*   osal_mutex_t;
+typedef void*   osal_mq_t;
+typedef void*   osal_timer_t;
+typedef void*   osal_pool_t;
+
+//-----------------------------------------------------------------------------
+// Task
+//-----------------------------------------------------------------------------
+
+typedef void (*osal_task_entry_t)(void *arg);
+
+osal_task_t osal_task_create(const char *name,              /* 名称 */
+                             uint32_t stack_size,           /* 堆栈大小 */
+                             uint32_t prio,                 /* 优先级 */
+                             uint32_t slice,                /* 时间片 */
+                             osal_task_entry_t entry,       /* 入口函数 */
+                             void *args);                   /* 函数参数 */
+
+void osal_task_delete(osal_task_t task);
+
+void osal_task_suspend(osal_task_t task);
+void osal_task_resume(osal_task_t task);
+void osal_task_sleep(uint32_t ms);
+void osal_task_sleep_until(uint32_t *prev_ticks, uint32_t inc_ticks);
+
+/*
+ * Periodic task, released every period_us and the priority is rate monotonic.
+ * The entry is called once for a release and must return. Jitter, execution
+ * time and deadline misses are recorded, the hook is called when a job ends
+ * after its deadline. Delete it by osal_task_delete_periodic().
+ */
+typedef void (*osal_overrun_hook_t)(osal_task_t task, uint32_t late_us);
+
+osal_task_t osal_task_create_periodic(const char *name,
+                                     uint32_t period_us,
+                                     uint32_t deadline_us,
+                                     osal_task_entry_t entry);
+
+void osal_task_delete_periodic(osal_task_t task);
+void osal_task_set_overrun_hook(osal_task_t task, osal_overrun_hook_t hook);
+
+/*
+ * Stackless task, runs on the stack of the main loop. pt is a pesudo_pt_t or
+ * the struct it is the first member, passed to the entry as arg. The entry is
+ * a protothread of pesudo_pt.h, it awaits psched objects. The task is deleted
+ * when the thread reaches pt_end().
+ */
+osal_task_t osal_task_create_stackless(const char *name,
+                                       uint32_t prio,
+                                       osal_task_entry_t entry,
+                                       void *pt);
+
+/*
+ * Run-to-completion task, the entry is called once as one cycle and must
+ * return. It has no stack of its own, all of them run on the stack of the
+ * main loop, so it must not call a blocking function here (see "Blocking
+ * Check" below). The oneshot task is deleted after it runs once, as a init
+ * task.
+ */
+osal_task_t osal_task_create_rtc(const char *name,
+                                 uint32_t prio,
+                                 osal_task_entry_t entry,
+                                 void *args);
+
+osal_task_t osal_task_create_oneshot(const char *name,
+                                     uint32_t prio,
+                                     osal_task_entry_t entry,
+                                     void *args);
+
+void osal_task_delete_rtc(osal_task_t task);
+
+//-----------------------------------------------------------------------------
+// Event
+//-----------------------------------------------------------------------------
+
+osal_event_t osal_event_create(const char *name, uint32_t opt);
+void osal_event_delete(osal_event_t event);
+
+int  osal_event_send(osal_event_t event, uint32_t bits);
+uint32_t osal_event_receive(osal_event_t event, uint32_t bits,
+                            uint32_t flag, uint32_t timeout_ms);
+void osal_event_set_bits(osal_event_t event, uint32_t bits);
+void osal_event_set_os_opt(osal_event_t event, uint32_t opt);
+
+//-----------------------------------------------------------------------------
+// Semphore
+//-----------------------------------------------------------------------------
+
+osal_sem_t osal_sem_create(const char *name, uint32_t opt, uint32_t initial_count);
+void osal_sem_delete(osal_sem_t sem);
+
+int osal_sem_obtain(osal_sem_t sem, uint32_t timeout);
+int osal_sem_release(osal_sem_t sem);
+void osal_sem_reset(osal_sem_t sem);
+void osal_sem_set_os_opt(osal_sem_t sem, uint32_t opt);
+
+//-----------------------------------------------------------------------------
+// Mutex
+//-----------------------------------------------------------------------------
+
+osal_mutex_t osal_mutex_create(const char *name, uint32_t opt);
+void osal_mutex_delete(osal_mutex_t mutex);
+int osal_mutex_obtain(osal_mutex_t mutex, uint32_t timeout_ms);
+int osal_mutex_release(osal_mutex_t mutex);
+void osal_mutex_set_os_opt(osal_mutex_t mutex, uint32_t opt);
+
+//-----------------------------------------------------------------------------
+// Message Queue
+//-----------------------------------------------------------------------------
+
+osal_mq_t osal_mq_create(const char *name, uint32_t opt,
+                         uint32_t item_size, uint32_t max_msgs);
+void osal_mq_delete(osal_mq_t mq);
+int osal_mq_send(osal_mq_t mq, const void *msg, int size);
+int osal_mq_receive(osal_mq_t mq, void *msg, int size, uint32_t timeout);
+void osal_mq_set_os_opt(osal_mq_t mq, uint32_t opt);
+
+int osal_mq_is_full(osal_mq_t mq);
+int osal_mq_flush(osal_mq_t mq);
+
+/*
+ * Zero copy loan, for psched_mq of pesudo_waitq.h only (the mq of libbsp
+ * copies), see psched_mq_loan(). The sender writes in a free slot and
+ * commits it, the receiver reads the message in place and releases it.
+ * Return OSAL_ERR_OK, OSAL_ERR_TIMEOUT (full or empty), OSAL_ERR_INVAL, also
+ * when mq is not a psched_mq.
+ */
+int osal_mq_loan(osal_mq_t mq, void **ptr);
+int osal_mq_commit(osal_mq_t mq, void *ptr);
+int osal_mq_receive_ref(osal_mq_t mq, void **ptr);
+int osal_mq_release(osal_mq_t mq, void *ptr);
+
+/*
+ * Batch, for psched_mq of pesudo_waitq.h only, see psched_mq_send_n(). The
+ * messages are of item_size bytes one after another.
+ *
+ * osal_mq_send_n() returns the count sent, less than n when full.
+ *
+ * osal_mq_receive_n() receives up to max messages when there are min (at
+ * most max_msgs), the receiver is waked once when min messages are in, by
+ * psched_wait_level(), the other receivers of the queue are not affected:
+ *   task with stack: waits for min messages or timeout, then takes what
+ *     there is.
+ *   task without stack: returns 0, the task runs again when there are min
+ *     messages or timeout, then it takes what there is.
+ *   libbsp task: doesn't wait.
+ * Return the count received.
+ *
+ * Both return -1 when mq is not a psched_mq (a queue of libbsp, a mailbox or
+ * a variable length queue).
+ */
+int osal_mq_send_n(osal_mq_t mq, const void *msgs, int n);
+int osal_mq_receive_n(osal_mq_t mq, void *buf, int max, int min, uint32_t timeout);
+
+/*
+ * Latest-value mailbox, OS_PESUDO only: osal_mq_create() with
+ * OSAL_OPT_OVERWRITE makes a psched_mbox of pesudo_waitq.h, max_msgs is not
+ * used. A send overwrites the message without lock and never fails as full,
+ * it can be called in isr directly. osal_mq_receive() gets the newest message
+ * not received yet, OSAL_ERR_TIMEOUT if none; it never waits, wait it by
+ * osal_wait_any(). One sender and one receiver.
+ *
+ * osal_mq_receive_latest() also gives the number of the message and count of
+ * the messages overwritten before received (seq and overrun may be NULL).
+ */
+int osal_mq_receive_latest(osal_mq_t mq, void *msg, int size,
+                           uint32_t *seq, uint32_t *overrun);
+
+osal_mq_t osal_mbox_create(const char *name, uint32_t opt, uint32_t item_size);
+void osal_mbox_delete(osal_mq_t mq);
+int osal_mbox_send(osal_mq_t mq, const void *msg, int size);
+int osal_mbox_receive(osal_mq_t mq, void *msg, int size);
+int osal_mbox_flush(osal_mq_t mq);
+void osal_mbox_set_os_opt(osal_mq_t mq, uint32_t opt);
+
+/*
+ * Variable length queue, OS_PESUDO only: a psched_vmq of pesudo_waitq.h, the
+ * messages are records of buf_size bytes, a message takes its size + 2.
+ * msg_max is the largest message (0: buf_size - 2), a larger send is
+ * OSAL_ERR_INVAL, no room is OSAL_ERR_TIMEOUT. osal_mq_receive() never waits
+ * and is OSAL_ERR_INVAL if size is less than the message.
+ *
+ * osal_mq_receive_size() returns the length of the message received, 0 if
+ * empty, -(length) if size is less than it.
+ *
+ * In isr use osal_isr_mq_send(), it is deferred like a queue of libbsp, so a
+ * message of at most OSAL_ISR_MSG_SIZE.
+ */
+osal_mq_t osal_mq_create_bytes(const char *name, uint32_t opt,
+                               uint32_t buf_size, uint32_t msg_max);
+int osal_mq_receive_size(osal_mq_t mq, void *msg, int size);
+
+void osal_vmq_delete(osal_mq_t mq);
+int osal_vmq_send(osal_mq_t mq, const void *msg, int size);
+int osal_vmq_receive(osal_mq_t mq, void *msg, int size);
+int osal_vmq_is_full(osal_mq_t mq);
+int osal_vmq_flush(osal_mq_t mq);
+void osal_vmq_set_os_opt(osal_mq_t mq, uint32_t opt);
+
+//-----------------------------------------------------------------------------
+// Timer
+//-----------------------------------------------------------------------------
+
+osal_timer_t osal_timer_create(const char *name,
+                               osal_task_entry_t handler,
+                               void *argument,
+                               uint32_t timeout_ms,
+                               bool is_period);
+
+void osal_timer_delete(osal_timer_t timer);
+
+void osal_timer_start(osal_timer_t timer, uint32_t timeout_ms);
+void osal_timer_stop(osal_timer_t timer);
+
+//-----------------------------------------------------------------------------
+// High Resolution Timer
+//-----------------------------------------------------------------------------
+
+/*
+ * Timer in us, by the comparator of HPET (src/hal/hpet/hrtimer.c), not the
+ * ms tick. The handler is called in the main loop (deferred from the HPET
+ * interrupt), so it may signal objects but must not block. Don't call these
+ * in isr.
+ */
+typedef void*   osal_hrtimer_t;
+
+osal_hrtimer_t osal_hrtimer_create(const char *name,
+                                   osal_task_entry_t handler,
+                                   void *argument,
+                                   uint32_t timeout_us,
+                                   bool is_period);
+
+void osal_hrtimer_delete(osal_hrtimer_t timer);
+
+/*
+ * timeout_us 0: use the timeout of create. Restart if it is running.
+ * Return OSAL_ERR_OK, OSAL_ERR_INVAL
+ */
+int osal_hrtimer_start(osal_hrtimer_t timer, uint32_t timeout_us);
+void osal_hrtimer_stop(osal_hrtimer_t timer);
+
+//-----------------------------------------------------------------------------
+// Memory Pool
+//-----------------------------------------------------------------------------
+
+/*
+ * Fixed-size block pool, O(1) alloc/free, can be called in isr.
+ */
+#define OSAL_POOL_MAX_ITEMS     1024            /* 32 x 32 bits bitmap */
+
+osal_pool_t osal_pool_create(const char *name, uint32_t item_size, uint32_t count);
+
+/*
+ * The blocks are in the DMA heap class, every block starts at a cache line
+ * and item_size is rounded up to cache lines, so a block can be given to DMA
+ * and flushed or invalidated alone.
+ */
+#define OSAL_POOL_DMA_ALIGN     64              /* DMA_CACHE_LINE of dma_buf.h */
+
+osal_pool_t osal_pool_create_dma(const char *name, uint32_t item_size, uint32_t count);
+void osal_pool_delete(osal_pool_t pool);
+
+void *osal_pool_alloc(osal_pool_t pool);
+int osal_pool_free(osal_pool_t pool, void *ptr);
+uint32_t osal_pool_free_count(osal_pool_t pool);
+
+//-----------------------------------------------------------------------------
+// Wait Multiple Objects
+//-----------------------------------------------------------------------------
+
+/*
+ * Wait any of the objects (psched_sem/event/mq of pesudo_waitq.h), return the
+ * index of the ready object, OSAL_WAIT_PENDING when the task will be waked
+ * by one of them or timeout, see psched_wait_any(). The objects of libbsp
+ * (osal_sem_create(), osal_mq_create() ...) can't be waited, OSAL_WAIT_INVAL.
+ */
+#define OSAL_WAIT_OBJS_MAX      4
+#define OSAL_WAIT_PENDING       (-1)            /* 返回后等待 */
+#define OSAL_WAIT_TIMEOUT       (-2)            /* 超时 */
+#define OSAL_WAIT_INVAL         (-4)            /* 参数错误 */
+
+int osal_wait_any(void *objects[], int n, uint32_t timeout_ms);
+
+//-----------------------------------------------------------------------------
+// Signal from ISR
+//-----------------------------------------------------------------------------
+
+/*
+ * Called in isr only. The operation is put in a lock-free queue and done by
+ * the main loop later, see pesudo_defer.h. Return 0, -1 if the queue is full
+ * or the message is larger than OSAL_ISR_MSG_SIZE. A mailbox doesn't lock, it
+ * is written at once; a variable length queue is deferred as the others.
+ */
+#define OSAL_ISR_MSG_SIZE       16
+
+int osal_isr_sem_release(osal_sem_t sem);
+int osal_isr_event_send(osal_event_t event, uint32_t bits);
+int osal_isr_mq_send(osal_mq_t mq, const void *msg, int size);
+
+//-----------------------------------------------------------------------------
+// Other
+//-----------------------------------------------------------------------------
+
+int osal_is_osrunning(void);        /* return 1 == running */
+
+size_t osal_enter_critical_section(void);
+void osal_leave_critical_section(size_t flag);
+
+void osal_msleep(uint32_t ms);
+
+void *osal_malloc(size_t size);
+void osal_free(void *ptr);
+
+//-----------------------------------------------------------------------------
+// 字符串常量
+//-----------------------------------------------------------------------------
+
+#define STR_OSAL_CREATE_TASK_FAIL   "create osal task %s fail"
+#define STR_OSAL_CREATE_EVENT_FAIL  "create osal event %s fail"
+#define STR_OSAL_CREATE_SEM_FAIL    "create osal semphore %s fail"
+#define STR_OSAL_CREATE_MUTEX_FAIL  "create osal mutex %s fail"
+#define STR_OSAL_CREATE_MQ_FAIL     "create osal message queue %s fail"
+#define STR_OSAL_CREATE_TIMER_FAIL  "create osal timer %s fail"
+#define STR_OSAL_CREATE_POOL_FAIL   "create osal memory pool %s fail"
+
+//-----------------------------------------------------------------------------
+// Blocking Check
+//-----------------------------------------------------------------------------
+
+/*
+ * The tasks without stack (rtc, oneshot, stackless) share the stack of the
+ * main loop, a blocking call in them would stop all the tasks. In debug build
+ * the blocking calls are checked: when the caller has no stack, it is logged
+ * once for the task and the call doesn't wait (timeout 0).
+ *
+ * Return 1 if the caller must not block.
+ */
+int osal_check_blocking(const char *func);
+
+#ifndef OSAL_CHECK_BLOCKING
+#if defined(NDEBUG)
+#define OSAL_CHECK_BLOCKING     0
+#else
+#define OSAL_CHECK_BLOCKING     1
+#endif
+#endif
+
+#if OSAL_CHECK_BLOCKING && defined(OS_PESUDO)
+
+#define osal_task_sleep(ms)                                                 \
+    (osal_check_blocking("osal_task_sleep") ? (void)0 : osal_task_sleep(ms))
+
+#define osal_task_sleep_until(prev_ticks, inc_ticks)                        \
+    (osal_check_blocking("osal_task_sleep_until") ? (void)0 :               \
+     osal_task_sleep_until(prev_ticks, inc_ticks))
+
+#define osal_msleep(ms)                                                     \
+    (osal_check_blocking("osal_msleep") ? (void)0 : osal_msleep(ms))
+
+#define OSAL_CHECK_TIMEOUT(func, timeout)                                   \
+    (((timeout) && osal_check_blocking(func)) ? 0 : (timeout))
+
+#define osal_event_receive(event, bits, flag, timeout_ms)                   \
+    osal_event_receive(event, bits, flag,                                   \
+                       OSAL_CHECK_TIMEOUT("osal_event_receive", timeout_ms))
+
+#define osal_sem_obtain(sem, timeout)                                       \
+    osal_sem_obtain(sem, OSAL_CHECK_TIMEOUT("osal_sem_obtain", timeout))
+
+#define osal_mutex_obtain(mutex, timeout_ms)                                \
+    osal_mutex_obtain(mutex, OSAL_CHECK_TIMEOUT("osal_mutex_obtain", timeout_ms))
+
+#define osal_mq_receive(mq, msg, size, timeout)                             \
+    osal_mq_receive(mq, msg, size, OSAL_CHECK_TIMEOUT("osal_mq_receive", timeout))
+
+#endif // #if OSAL_CHECK_BLOCKING
+
+//-----------------------------------------------------------------------------
+// Mailbox and Variable Length Queue
+//-----------------------------------------------------------------------------
+
+#if defined(OS_PESUDO)
+
+/*
+ * The handles of a mailbox and a variable length queue are tagged, so
+ * osal_mq_*() go to them, the others to libbsp.
+ */
+#define OSAL_MQ_MBOX_TAG        ((uintptr_t)0x1)
+#define OSAL_MQ_VMQ_TAG         ((uintptr_t)0x2)
+#define OSAL_MQ_TAG_MASK        ((uintptr_t)0x3)
+
+#define OSAL_MQ_IS_MBOX(mq)     (((uintptr_t)(mq) & OSAL_MQ_TAG_MASK) == OSAL_MQ_MBOX_TAG)
+#define OSAL_MQ_IS_VMQ(mq)      (((uintptr_t)(mq) & OSAL_MQ_TAG_MASK) == OSAL_MQ_VMQ_TAG)
+
+static inline osal_mq_t osal_mq_create_any(const char *name, uint32_t opt,
+                                           uint32_t item_size, uint32_t max_msgs)
+{
+    if (opt & OSAL_OPT_OVERWRITE)
+        return osal_mbox_create(name, opt, item_size);
+    return osal_mq_create(name, opt, item_size, max_msgs);
+}
+
+static inline void osal_mq_delete_any(osal_mq_t mq)
+{
+    if (OSAL_MQ_IS_MBOX(mq))
+        osal_mbox_delete(mq);
+    else if (OSAL_MQ_IS_VMQ(mq))
+        osal_vmq_delete(mq);
+    else
+        osal_mq_delete(mq);
+}
+
+static inline int osal_mq_send_any(osal_mq_t mq, const void *msg, int size)
+{
+    if (OSAL_MQ_IS_MBOX(mq))
+        return osal_mbox_send(mq, msg, size);
+    if (OSAL_MQ_IS_VMQ(mq))
+        return osal_vmq_send(mq, msg, size);
+    return osal_mq_send(mq, msg, size);
+}
+
+static inline int osal_mq_receive_any(osal_mq_t mq, void *msg, int size, uint32_t timeout)
+{
+    if (OSAL_MQ_IS_MBOX(mq))
+        return osal_mbox_receive(mq, msg, size);
+    if (OSAL_MQ_IS_VMQ(mq))
+        return osal_vmq_receive(mq, msg, size);
+    return osal_mq_receive(mq, msg, size, timeout);
+}
+
+static inline void osal_mq_set_os_opt_any(osal_mq_t mq, uint32_t opt)
+{
+    if (OSAL_MQ_IS_MBOX(mq))
+        osal_mbox_set_os_opt(mq, opt);
+    else if (OSAL_MQ_IS_VMQ(mq))
+        osal_vmq_set_os_opt(mq, opt);
+    else
+        osal_mq_set_os_opt(mq, opt);
+}
+
+static inline int osal_mq_is_full_any(osal_mq_t mq)
+{
+    if (OSAL_MQ_IS_MBOX(mq))
+        return 0;
+    if (OSAL_MQ_IS_VMQ(mq))
+        return osal_vmq_is_full(mq);
+    return osal_mq_is_full(mq);
+}
+
+static inline int osal_mq_flush_any(osal_mq_t mq)
+{
+    if (OSAL_MQ_IS_MBOX(mq))
+        return osal_mbox_flush(mq);
+    if (OSAL_MQ_IS_VMQ(mq))
+        return osal_vmq_flush(mq);
+    return osal_mq_flush(mq);
+}
+
+#undef osal_mq_receive
+
+#define osal_mq_create          osal_mq_create_any
+#define osal_mq_delete          osal_mq_delete_any
+#define osal_mq_send            osal_mq_send_any
+#define osal_mq_receive         osal_mq_receive_any
+#define osal_mq_set_os_opt      osal_mq_set_os_opt_any
+#define osal_mq_is_full         osal_mq_is_full_any
+#define osal_mq_flush           osal_mq_flush_any
+
+#endif // #if defined(OS_PESUDO)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _OSAL_H
+
+
@@ -0,0 +1,49 @@
+/*
+ * osal_isr.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+
+#if defined(OS_PESUDO)
+
+#include "pesudo_defer.h"
+
+#if (OSAL_ISR_MSG_SIZE != PESUDO_DEFER_MSG_SIZE)
+#error "osal isr defination is not same as pesudo_defer"
+#endif
+
+int osal_isr_sem_release(osal_sem_t sem)
+{
+    return pesudo_defer_osal_sem_release(sem);
+}
+
+int osal_isr_event_send(osal_event_t event, uint32_t bits)
+{
+    return pesudo_defer_osal_event_send(event, bits);
+}
+
+int osal_isr_mq_send(osal_mq_t mq, const void *msg, int size)
+{
+    /*
+     * 邮箱的发送不加锁, 在 isr 中直接写入
+     */
+    if (OSAL_MQ_IS_MBOX(mq))
+    {
+        return osal_mbox_send(mq, msg, size) == OSAL_ERR_OK ? 0 : -1;
+    }
+
+    /*
+     * 变长队列和 libbsp 的队列一样复制到 defer 队列, 由主循环的
+     * osal_mq_send() 发送, 消息不超过 OSAL_ISR_MSG_SIZE
+     */
+    return pesudo_defer_osal_mq_send(mq, msg, size);
+}
+
+#endif // #if defined(OS_PESUDO)
+
+/*
+ * @@ END
+ */
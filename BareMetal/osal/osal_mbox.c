@@ -0,0 +1,89 @@
+/*
+ * osal_mbox.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+
+#if defined(OS_PESUDO)
+
+#include "pesudo_waitq.h"
+
+static inline psched_mbox_t *mbox_of(osal_mq_t mq)
+{
+    return (psched_mbox_t *)((uintptr_t)mq & ~OSAL_MQ_TAG_MASK);
+}
+
+osal_mq_t osal_mbox_create(const char *name, uint32_t opt, uint32_t item_size)
+{
+    psched_mbox_t *mbox;
+
+    mbox = psched_mbox_create(name, opt & ~OSAL_OPT_OVERWRITE, item_size);
+    if (!mbox)
+    {
+        return NULL;
+    }
+
+    return (osal_mq_t)((uintptr_t)mbox | OSAL_MQ_MBOX_TAG);
+}
+
+void osal_mbox_delete(osal_mq_t mq)
+{
+    psched_mbox_delete(mbox_of(mq));
+}
+
+int osal_mbox_send(osal_mq_t mq, const void *msg, int size)
+{
+    return psched_mbox_send(mbox_of(mq), msg, size);
+}
+
+int osal_mbox_receive(osal_mq_t mq, void *msg, int size)
+{
+    return psched_mbox_receive(mbox_of(mq), msg, size, NULL);
+}
+
+int osal_mbox_flush(osal_mq_t mq)
+{
+    psched_mbox_flush(mbox_of(mq));
+    return OSAL_ERR_OK;
+}
+
+void osal_mbox_set_os_opt(osal_mq_t mq, uint32_t opt)
+{
+    psched_mbox_t *mbox = mbox_of(mq);
+
+    if (mbox)
+    {
+        mbox->obj.opt = opt & ~OSAL_OPT_OVERWRITE;
+    }
+}
+
+int osal_mq_receive_latest(osal_mq_t mq, void *msg, int size,
+                           uint32_t *seq, uint32_t *overrun)
+{
+    psched_mbox_t *mbox;
+    int rt;
+
+    if (!OSAL_MQ_IS_MBOX(mq))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    mbox = mbox_of(mq);
+    rt = psched_mbox_receive(mbox, msg, size, seq);
+
+    if (overrun)
+    {
+        *overrun = mbox ? mbox->overrun : 0;
+    }
+
+    return rt;
+}
+
+#endif // #if defined(OS_PESUDO)
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,103 @@
+/*
+ * osal_mq_batch.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+
+#if defined(OS_PESUDO)
+
+#include "pesudo_sched.h"
+#include "pesudo_waitq.h"
+
+/*
+ * osal_mq_create() 的队列是 libbsp 的, 邮箱和变长队列的句柄带标记, 都不是
+ * psched_mq, 返回 -1
+ */
+int osal_mq_send_n(osal_mq_t mq, const void *msgs, int n)
+{
+    if (!psched_mq_valid(mq))
+    {
+        return -1;
+    }
+
+    return psched_mq_send_n((psched_mq_t *)mq, msgs, n);
+}
+
+int osal_mq_receive_n(osal_mq_t mq, void *buf, int max, int min, uint32_t timeout)
+{
+    psched_mq_t *q = (psched_mq_t *)mq;
+    psched_task_t *task = psched_current();
+    int got, rt;
+
+    if (!psched_mq_valid(q))
+    {
+        return -1;
+    }
+
+    if (!buf || (max <= 0))
+    {
+        return 0;
+    }
+
+    /*
+     * 队列装不下 min 条时永远等不到
+     */
+    if ((uint32_t)max > q->max_msgs)
+    {
+        max = (int)q->max_msgs;
+    }
+
+    if (min < 1)
+    {
+        min = 1;
+    }
+    else if (min > max)
+    {
+        min = max;
+    }
+
+    /*
+     * 没有堆栈的任务上次等待超时, 这次取走已有的消息
+     */
+    if (task && !(task->flags & PS_FLAG_STACK) &&
+        (psched_wait_result() == PSCHED_WAIT_TIMEOUT))
+    {
+        min = 1;
+    }
+
+    got = psched_mq_receive_n(q, buf, max, min);
+    if ((got > 0) || (timeout == 0) || !task)
+    {
+        return got;
+    }
+
+    /*
+     * 消息数达到 min 时才唤醒, 不是每条消息唤醒一次. 阈值只属于这个
+     * 等待者, 队列的其它接收者不受影响
+     */
+    rt = psched_wait_level(q, (uint32_t)min, timeout);
+
+    if (rt >= 0)
+    {
+        return psched_mq_receive_n(q, buf, max, min);
+    }
+
+    /*
+     * 有堆栈的任务在这里等待后继续, 超时也取走已有的消息
+     */
+    if ((task->flags & PS_FLAG_STACK) && (rt == PSCHED_WAIT_TIMEOUT))
+    {
+        return psched_mq_receive_n(q, buf, max, 1);
+    }
+
+    return 0;
+}
+
+#endif // #if defined(OS_PESUDO)
+
+/*
+ * @@ END
+ */
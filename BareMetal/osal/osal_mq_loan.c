@@ -0,0 +1,61 @@
+/*
+ * osal_mq_loan.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+
+#if defined(OS_PESUDO)
+
+#include "pesudo_waitq.h"
+
+/*
+ * osal_mq_create() 的队列是 libbsp 的, 邮箱和变长队列的句柄带标记, 都不能借出
+ */
+int osal_mq_loan(osal_mq_t mq, void **ptr)
+{
+    if (!psched_mq_valid(mq))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    return psched_mq_loan((psched_mq_t *)mq, ptr);
+}
+
+int osal_mq_commit(osal_mq_t mq, void *ptr)
+{
+    if (!psched_mq_valid(mq))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    return psched_mq_commit((psched_mq_t *)mq, ptr);
+}
+
+int osal_mq_receive_ref(osal_mq_t mq, void **ptr)
+{
+    if (!psched_mq_valid(mq))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    return psched_mq_receive_ref((psched_mq_t *)mq, ptr);
+}
+
+int osal_mq_release(osal_mq_t mq, void *ptr)
+{
+    if (!psched_mq_valid(mq))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    return psched_mq_release((psched_mq_t *)mq, ptr);
+}
+
+#endif // #if defined(OS_PESUDO)
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,37 @@
+/*
+ * osal_periodic.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+
+#if defined(OS_PESUDO)
+
+#include "pesudo_sched.h"
+
+osal_task_t osal_task_create_periodic(const char *name,
+                                     uint32_t period_us,
+                                     uint32_t deadline_us,
+                                     osal_task_entry_t entry)
+{
+    return psched_task_create_periodic(name, psched_rm_prio(period_us),
+                                       period_us, deadline_us, entry, NULL);
+}
+
+void osal_task_delete_periodic(osal_task_t task)
+{
+    psched_task_delete((psched_task_t *)task);
+}
+
+void osal_task_set_overrun_hook(osal_task_t task, osal_overrun_hook_t hook)
+{
+    psched_task_set_overrun_hook((psched_task_t *)task, (psched_overrun_hook_t)hook);
+}
+
+#endif // #if defined(OS_PESUDO)
+
+/*
+ * @@ END
+ */
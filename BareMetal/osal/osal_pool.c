@@ -0,0 +1,247 @@
+/*
+ * osal_pool.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Fixed-size block pool.
+ *
+ * All blocks are allocated by one malloc() at create time, a two level bitmap
+ * record the blank blocks:
+ *
+ *   summary: bit w = 1, map[w] has blank block
+ *   map[w]:  bit b = 1, block (w * 32 + b) is blank
+ *
+ * so alloc/free is O(1) and only need a short critical section, without the
+ * heap mutex, it can be used in task and isr.
+ *
+ * The blocks of osal_pool_create_dma() are a second allocation of the DMA
+ * heap class, cache line aligned, every block takes whole cache lines.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "bsp.h"
+#include "osal.h"
+#include "memory_man.h"
+
+extern int fls(int x);
+
+//-----------------------------------------------------------------------------
+
+#define POOL_ALIGNMENT      8
+#define POOL_MAP_WORDS      (OSAL_POOL_MAX_ITEMS / 32)
+
+#ifndef align_up
+#define align_up(num, align)    (((num) + ((align)-1)) & ~((align)-1))
+#endif
+
+struct osal_pool
+{
+    char      name[16];
+    uint32_t  item_size;                        /* 对齐后的块大小 */
+    uint32_t  count;                            /* 块总数 */
+    uint32_t  free_count;                       /* 空闲块数 */
+    uint32_t  summary;                          /* 第一级位图 */
+    uint32_t  map[POOL_MAP_WORDS];              /* 第二级位图, 1=空闲 */
+    unsigned char *items;                       /* 块起始地址 */
+    unsigned char *dma_items;                   /* DMA 块, 单独分配 */
+};
+
+/*
+ * index of lowest set bit, x must not be 0
+ */
+static inline int pool_ffs(uint32_t x)
+{
+    return fls((int)(x & (~x + 1))) - 1;
+}
+
+//-----------------------------------------------------------------------------
+
+static void pool_init(struct osal_pool *pool, const char *name,
+                      uint32_t item_size, uint32_t count)
+{
+    uint32_t i;
+
+    memset(pool, 0, sizeof(struct osal_pool));
+    if (name)
+    {
+        strncpy(pool->name, name, sizeof(pool->name) - 1);
+    }
+
+    pool->item_size  = item_size;
+    pool->count      = count;
+    pool->free_count = count;
+
+    for (i = 0; i < count; i++)
+    {
+        pool->map[i / 32] |= 1U << (i % 32);
+    }
+
+    for (i = 0; i < POOL_MAP_WORDS; i++)
+    {
+        if (pool->map[i])
+            pool->summary |= 1U << i;
+    }
+}
+
+osal_pool_t osal_pool_create(const char *name, uint32_t item_size, uint32_t count)
+{
+    struct osal_pool *pool;
+
+    if ((item_size == 0) || (count == 0) || (count > OSAL_POOL_MAX_ITEMS))
+    {
+        LOG_ERR(STR_OSAL_CREATE_POOL_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    item_size = align_up(item_size, POOL_ALIGNMENT);
+
+    pool = (struct osal_pool *)malloc(align_up(sizeof(struct osal_pool), POOL_ALIGNMENT) +
+                                      (size_t)item_size * count);
+    if (!pool)
+    {
+        LOG_ERR(STR_OSAL_CREATE_POOL_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    pool_init(pool, name, item_size, count);
+    pool->items = (unsigned char *)pool + align_up(sizeof(struct osal_pool), POOL_ALIGNMENT);
+
+    return (osal_pool_t)pool;
+}
+
+osal_pool_t osal_pool_create_dma(const char *name, uint32_t item_size, uint32_t count)
+{
+    struct osal_pool *pool;
+    unsigned char *items;
+    size_t size;
+
+    if ((item_size == 0) || (count == 0) || (count > OSAL_POOL_MAX_ITEMS))
+    {
+        LOG_ERR(STR_OSAL_CREATE_POOL_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    item_size = align_up(item_size, OSAL_POOL_DMA_ALIGN);
+    size = (size_t)item_size * count;
+
+    pool = (struct osal_pool *)malloc(sizeof(struct osal_pool));
+#if !BSP_USE_FS
+    items = (unsigned char *)aligned_malloc_class(size, OSAL_POOL_DMA_ALIGN, HEAP_CLASS_DMA);
+#else
+    items = (unsigned char *)aligned_malloc(size, OSAL_POOL_DMA_ALIGN);
+#endif
+    if (!pool || !items)
+    {
+        free(pool);
+        aligned_free(items);
+        LOG_ERR(STR_OSAL_CREATE_POOL_FAIL, name ? name : "");
+        return NULL;
+    }
+
+    pool_init(pool, name, item_size, count);
+    pool->items     = items;
+    pool->dma_items = items;
+
+    return (osal_pool_t)pool;
+}
+
+void osal_pool_delete(osal_pool_t pool)
+{
+    if (pool)
+    {
+        if (((struct osal_pool *)pool)->dma_items)
+        {
+            aligned_free(((struct osal_pool *)pool)->dma_items);
+        }
+
+        free(pool);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void *osal_pool_alloc(osal_pool_t pool)
+{
+    struct osal_pool *p = (struct osal_pool *)pool;
+    size_t flag;
+    int w, b;
+
+    if (!p)
+    {
+        return NULL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    if (!p->summary)
+    {
+        osal_leave_critical_section(flag);
+        return NULL;
+    }
+
+    w = pool_ffs(p->summary);
+    b = pool_ffs(p->map[w]);
+
+    p->map[w] &= ~(1U << b);
+    if (!p->map[w])
+        p->summary &= ~(1U << w);
+
+    p->free_count--;
+
+    osal_leave_critical_section(flag);
+
+    return p->items + (size_t)(w * 32 + b) * p->item_size;
+}
+
+int osal_pool_free(osal_pool_t pool, void *ptr)
+{
+    struct osal_pool *p = (struct osal_pool *)pool;
+    size_t offset, flag;
+    uint32_t index;
+
+    if (!p || !ptr || ((unsigned char *)ptr < p->items))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    offset = (size_t)((unsigned char *)ptr - p->items);
+    index  = (uint32_t)(offset / p->item_size);
+
+    if ((offset % p->item_size) || (index >= p->count))
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    flag = osal_enter_critical_section();
+
+    /*
+     * double free
+     */
+    if (p->map[index / 32] & (1U << (index % 32)))
+    {
+        osal_leave_critical_section(flag);
+        return OSAL_ERR_INVAL;
+    }
+
+    p->map[index / 32] |= 1U << (index % 32);
+    p->summary |= 1U << (index / 32);
+    p->free_count++;
+
+    osal_leave_critical_section(flag);
+
+    return OSAL_ERR_OK;
+}
+
+uint32_t osal_pool_free_count(osal_pool_t pool)
+{
+    return pool ? ((struct osal_pool *)pool)->free_count : 0;
+}
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,26 @@
+/*
+ * osal_pt.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+
+#if defined(OS_PESUDO)
+
+#include "pesudo_pt.h"
+
+osal_task_t osal_task_create_stackless(const char *name,
+                                       uint32_t prio,
+                                       osal_task_entry_t entry,
+                                       void *pt)
+{
+    return pesudo_pt_create(name, prio, entry, (pesudo_pt_t *)pt);
+}
+
+#endif // #if defined(OS_PESUDO)
+
+/*
+ * @@ END
+ */
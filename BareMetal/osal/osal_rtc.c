@@ -0,0 +1,44 @@
+/*
+ * osal_rtc.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+
+#if defined(OS_PESUDO)
+
+#include "pesudo_sched.h"
+
+osal_task_t osal_task_create_rtc(const char *name,
+                                 uint32_t prio,
+                                 osal_task_entry_t entry,
+                                 void *args)
+{
+    return psched_task_create(name, prio, entry, args);
+}
+
+osal_task_t osal_task_create_oneshot(const char *name,
+                                     uint32_t prio,
+                                     osal_task_entry_t entry,
+                                     void *args)
+{
+    return psched_task_create_once(name, prio, entry, args);
+}
+
+void osal_task_delete_rtc(osal_task_t task)
+{
+    psched_task_delete((psched_task_t *)task);
+}
+
+int osal_check_blocking(const char *func)
+{
+    return psched_check_blocking(func);
+}
+
+#endif // #if defined(OS_PESUDO)
+
+/*
+ * @@ END
+ */
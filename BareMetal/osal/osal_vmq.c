@@ -0,0 +1,99 @@
+/*
+ * osal_vmq.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+
+#if defined(OS_PESUDO)
+
+#include "pesudo_waitq.h"
+
+static inline psched_vmq_t *vmq_of(osal_mq_t mq)
+{
+    return (psched_vmq_t *)((uintptr_t)mq & ~OSAL_MQ_TAG_MASK);
+}
+
+osal_mq_t osal_mq_create_bytes(const char *name, uint32_t opt,
+                               uint32_t buf_size, uint32_t msg_max)
+{
+    psched_vmq_t *vmq;
+
+    vmq = psched_vmq_create(name, opt, buf_size, msg_max);
+    if (!vmq)
+    {
+        return NULL;
+    }
+
+    return (osal_mq_t)((uintptr_t)vmq | OSAL_MQ_VMQ_TAG);
+}
+
+int osal_mq_receive_size(osal_mq_t mq, void *msg, int size)
+{
+    if (!OSAL_MQ_IS_VMQ(mq))
+    {
+        return 0;
+    }
+
+    return psched_vmq_receive(vmq_of(mq), msg, size);
+}
+
+void osal_vmq_delete(osal_mq_t mq)
+{
+    psched_vmq_delete(vmq_of(mq));
+}
+
+int osal_vmq_send(osal_mq_t mq, const void *msg, int size)
+{
+    return psched_vmq_send(vmq_of(mq), msg, size);
+}
+
+int osal_vmq_receive(osal_mq_t mq, void *msg, int size)
+{
+    int len = psched_vmq_receive(vmq_of(mq), msg, size);
+
+    if (len > 0)
+    {
+        return OSAL_ERR_OK;
+    }
+
+    return (len == 0) ? OSAL_ERR_TIMEOUT : OSAL_ERR_INVAL;
+}
+
+/*
+ * 放不下一个字节的消息
+ */
+int osal_vmq_is_full(osal_mq_t mq)
+{
+    psched_vmq_t *vmq = vmq_of(mq);
+
+    if (!vmq)
+    {
+        return 0;
+    }
+
+    return vmq->used + PSCHED_VMQ_HDR_SIZE >= vmq->buf_size;
+}
+
+int osal_vmq_flush(osal_mq_t mq)
+{
+    return psched_vmq_flush(vmq_of(mq));
+}
+
+void osal_vmq_set_os_opt(osal_mq_t mq, uint32_t opt)
+{
+    psched_vmq_t *vmq = vmq_of(mq);
+
+    if (vmq)
+    {
+        vmq->obj.opt = opt;
+    }
+}
+
+#endif // #if defined(OS_PESUDO)
+
+/*
+ * @@ END
+ */
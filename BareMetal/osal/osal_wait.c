@@ -0,0 +1,46 @@
+/*
+ * osal_wait.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+#include "osal.h"
+
+#if defined(OS_PESUDO)
+
+#include "pesudo_waitq.h"
+
+#if (OSAL_WAIT_OBJS_MAX != PSCHED_WAIT_MAX) || \
+    (OSAL_WAIT_PENDING != PSCHED_WAIT_NONE) || \
+    (OSAL_WAIT_TIMEOUT != PSCHED_WAIT_TIMEOUT) || \
+    (OSAL_WAIT_INVAL != PSCHED_WAIT_INVAL)
+#error "osal wait defination is not same as pesudo_sched"
+#endif
+
+int osal_wait_any(void *objects[], int n, uint32_t timeout_ms)
+{
+    void *objs[OSAL_WAIT_OBJS_MAX];
+    int i;
+
+    if (!objects || (n <= 0) || (n > OSAL_WAIT_OBJS_MAX))
+    {
+        return psched_wait_any(objects, n, timeout_ms);
+    }
+
+    /*
+     * 邮箱和变长队列的句柄带标记 (osal.h), 去掉后是 psched 对象
+     */
+    for (i=0; i<n; i++)
+    {
+        objs[i] = (void *)((uintptr_t)objects[i] & ~OSAL_MQ_TAG_MASK);
+    }
+
+    return psched_wait_any(objs, n, timeout_ms);
+}
+
+#endif // #if defined(OS_PESUDO)
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,267 @@
+/*
+ * memory_man.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Heap api beside malloc/free, implemented in ls2k300/misc/memory_man.c
+ *
+ * memory_man.c is compiled only when BSP_USE_FS is 0, else the heap is of
+ * libbsp. The api added by memory_man.c (class, statistics, tag and trace)
+ * is then inline and does nothing, so the callers need no #if.
+ */
+
+#ifndef _MEMORY_MAN_H
+#define _MEMORY_MAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bsp.h"
+
+//-----------------------------------------------------------------------------
+// Heap region & memory class
+//-----------------------------------------------------------------------------
+
+/*
+ * Every region has a memory class, the regions of same class share the free
+ * lists. malloc_class() try the class first, then fall back:
+ *
+ *   FAST: FAST → BULK → DMA
+ *   DMA:  DMA  → BULK → FAST
+ *   BULK: BULK → DMA  → FAST
+ *
+ * malloc() is malloc_class(size, HEAP_CLASS_BULK).
+ */
+#define HEAP_CLASS_FAST         0           /* 小而快, 控制环的状态 */
+#define HEAP_CLASS_DMA          1           /* 保留的 DMA 窗口 */
+#define HEAP_CLASS_BULK         2           /* 大块, 默认 */
+#define HEAP_CLASS_MAX          3
+
+#define HEAP_REGION_MAX         8
+#define HEAP_REGION_MIN         0x1000      /* 4K */
+
+int heap_add_region(void *addr, size_t size);       /* HEAP_CLASS_BULK */
+
+size_t get_heap_size(void);
+size_t get_heap_free_size(void);
+
+void *aligned_malloc(size_t size, unsigned int align);
+
+#if !BSP_USE_FS
+
+int heap_add_region_class(void *addr, size_t size, unsigned int cls);
+
+void *malloc_class(size_t size, unsigned int cls);
+void *aligned_malloc_class(size_t size, unsigned int align, unsigned int cls);
+
+int heap_class_size(unsigned int cls, size_t *total, size_t *free_bytes);
+
+#else
+
+static inline int heap_add_region_class(void *addr, size_t size, unsigned int cls)
+{
+    (void)cls;
+    return heap_add_region(addr, size);
+}
+
+static inline void *malloc_class(size_t size, unsigned int cls)
+{
+    (void)cls;
+    return malloc(size);
+}
+
+static inline void *aligned_malloc_class(size_t size, unsigned int align, unsigned int cls)
+{
+    (void)cls;
+    return aligned_malloc(size, align);
+}
+
+static inline int heap_class_size(unsigned int cls, size_t *total, size_t *free_bytes)
+{
+    (void)cls; (void)total; (void)free_bytes;
+    return -1;
+}
+
+#endif // #if !BSP_USE_FS
+
+//-----------------------------------------------------------------------------
+// Heap verify
+//-----------------------------------------------------------------------------
+
+int heap_verify_faulty_blocks(void);
+int heap_view_isolated_blocks(void);
+void dump_heap_list(void);
+
+void aligned_free(void *addr);
+void *aligned_realloc(void *ptr, size_t size, unsigned int align);
+
+//-----------------------------------------------------------------------------
+// Heap statistics
+//-----------------------------------------------------------------------------
+
+#define HEAP_HIST_BUCKETS       16          /* latency histogram, log2 of stable counter */
+
+typedef struct heap_stats
+{
+    size_t   total_bytes;                   /* 堆总大小 */
+    size_t   free_bytes;                    /* 剩余大小 */
+    size_t   peak_used_bytes;               /* 使用峰值 */
+    size_t   largest_free_block;            /* 最大空闲块 */
+    uint32_t free_block_count;              /* 空闲块数 */
+    uint32_t fragmentation;                 /* 碎片率 1/1000: 1 - largest / free */
+
+    uint32_t alloc_count;                   /* malloc 次数 */
+    uint32_t free_count;                    /* free 次数 */
+    uint32_t fail_count;                    /* malloc 失败次数 */
+
+    uint32_t alloc_max_cycles;              /* malloc 最大耗时 */
+    uint32_t free_max_cycles;               /* free 最大耗时 */
+    uint32_t alloc_hist[HEAP_HIST_BUCKETS]; /* [i]: 耗时在 [2^(i-1), 2^i) 内的次数 */
+    uint32_t free_hist[HEAP_HIST_BUCKETS];
+} heap_stats_t;
+
+#if !BSP_USE_FS
+
+int heap_stats(heap_stats_t *stats);
+void heap_stats_reset(void);                /* clear counters, histograms and peak */
+void heap_stats_show(void);                 /* print by printk */
+
+#else
+
+static inline int heap_stats(heap_stats_t *stats) { (void)stats; return -1; }
+static inline void heap_stats_reset(void) { }
+static inline void heap_stats_show(void) { }
+
+#endif
+
+//-----------------------------------------------------------------------------
+// Allocation tag
+//-----------------------------------------------------------------------------
+
+/*
+ * Every block record the tag when it is allocated, so the memory is counted
+ * per subsystem. Set the tag around the subsystem initialize or at the entry
+ * of its task. The tasks of pesudo_sched run with their heap_tag, default
+ * HEAP_TAG_APP.
+ */
+#define HEAP_TAG_NONE           0
+#define HEAP_TAG_LVGL           1
+#define HEAP_TAG_LWIP           2
+#define HEAP_TAG_FS             3
+#define HEAP_TAG_APP            4
+#define HEAP_TAG_MAX            8
+
+typedef struct heap_tag_stats
+{
+    size_t   used_bytes;                    /* 当前使用 */
+    size_t   peak_bytes;                    /* 使用峰值 */
+    size_t   budget_bytes;                  /* 预算, 0: 不限 */
+    uint32_t blocks;                        /* 当前块数 */
+} heap_tag_stats_t;
+
+#if !BSP_USE_FS
+
+unsigned int heap_set_tag(unsigned int tag);     /* return previous tag */
+void heap_set_tag_budget(unsigned int tag, size_t bytes);
+int heap_tag_stats(unsigned int tag, heap_tag_stats_t *stats);
+
+#else
+
+static inline unsigned int heap_set_tag(unsigned int tag) { (void)tag; return HEAP_TAG_NONE; }
+static inline void heap_set_tag_budget(unsigned int tag, size_t bytes) { (void)tag; (void)bytes; }
+static inline int heap_tag_stats(unsigned int tag, heap_tag_stats_t *stats)
+{
+    (void)tag; (void)stats;
+    return -1;
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+// Allocation trace
+//-----------------------------------------------------------------------------
+
+/*
+ * When HEAP_TRACE is 1 and the trace is started, malloc/free/realloc write a
+ * record into a ring, the oldest records are overwritten. Writer reserve the
+ * slot by atomic add, without lock, so it is cheap and can be used in isr.
+ *
+ * Dump layout: heap_trace_hdr_t, then records from the oldest. Decode it on
+ * host by tools/heap_trace/heap_trace.c
+ */
+#ifndef HEAP_TRACE
+#define HEAP_TRACE              1
+#endif
+
+#define HEAP_TRACE_MAGIC        0x43525448  /* "HTRC" */
+#define HEAP_TRACE_VERSION      1
+
+#define HEAP_TRACE_MALLOC       1           /* ptr, size */
+#define HEAP_TRACE_FREE         2           /* ptr */
+#define HEAP_TRACE_RESIZE       3           /* ptr, new size, resized in place */
+
+#define HEAP_TRACE_NO_TASK      0xFFFF
+
+typedef struct heap_trace_rec
+{
+    uint64_t timestamp;                     /* stable counter */
+    uint64_t ptr;
+    uint64_t caller;                        /* return address */
+    uint32_t size;
+    uint16_t task_id;                       /* pesudo_task ID */
+    uint8_t  op;                            /* HEAP_TRACE_XXX */
+    uint8_t  cls;                           /* HEAP_CLASS_XXX */
+} heap_trace_rec_t;                         /* 32 bytes */
+
+typedef struct heap_trace_hdr
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t rec_size;
+    uint32_t count;                         /* records followed */
+    uint32_t lost;                          /* overwritten records */
+    uint64_t counter_hz;                    /* timestamp frequency */
+} heap_trace_hdr_t;                         /* 24 bytes */
+
+/*
+ * write dump data, return bytes written, < 0 if error
+ */
+typedef int (*heap_trace_write_t)(const void *buf, int len, void *arg);
+
+#if !BSP_USE_FS
+
+int  heap_trace_start(unsigned int records);    /* power of 2, buffer by malloc */
+void heap_trace_stop(void);                     /* stop recording, keep records */
+void heap_trace_release(void);                  /* free the buffer */
+int  heap_trace_dump(heap_trace_write_t write, void *arg);
+
+#else
+
+static inline int  heap_trace_start(unsigned int records) { (void)records; return -1; }
+static inline void heap_trace_stop(void) { }
+static inline void heap_trace_release(void) { }
+static inline int  heap_trace_dump(heap_trace_write_t write, void *arg)
+{
+    (void)write; (void)arg;
+    return -1;
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _MEMORY_MAN_H
+
+/*
+ * @@ END
+ */
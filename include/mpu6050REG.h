@@ -30,4 +30,4 @@
 #define MPU6050_DEFAULT_ADDRESS 0x68
 
 #endif 
-
+
@@ -0,0 +1,126 @@
+/*
+ * stable_counter.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * LoongArch stable counter, a constant frequency 64 bits counter.
+ *
+ * It is much finer than get_clock_ticks() (ms), used for latency and cpu time
+ * accounting. Read it costs one instruction.
+ */
+
+#ifndef _STABLE_COUNTER_H
+#define _STABLE_COUNTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+extern unsigned long get_clock_ticks(void);
+
+#if __loongarch64
+
+static inline uint64_t stable_counter_read(void)
+{
+    uint64_t val;
+
+    __asm__ __volatile__("rdtime.d %0, $zero" : "=r"(val));
+
+    return val;
+}
+
+/*
+ * frequency = CPUCFG4.CC_FREQ * CPUCFG5.CC_MUL / CPUCFG5.CC_DIV
+ */
+static inline uint64_t stable_counter_hz(void)
+{
+    uint32_t base, muldiv, mul, div;
+
+    __asm__ __volatile__("cpucfg %0, %1" : "=r"(base)   : "r"(4));
+    __asm__ __volatile__("cpucfg %0, %1" : "=r"(muldiv) : "r"(5));
+
+    mul = muldiv & 0xFFFF;
+    div = muldiv >> 16;
+
+    if (!mul || !div)
+    {
+        return base;
+    }
+
+    return (uint64_t)base * mul / div;
+}
+
+#elif defined(__linux__)
+
+#include <time.h>
+
+/*
+ * Host build, ns of the monotonic clock
+ */
+static inline uint64_t stable_counter_read(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t stable_counter_hz(void)
+{
+    return 1000000000ULL;
+}
+
+#else
+
+/*
+ * Not LoongArch, use the ms clock-tick
+ */
+static inline uint64_t stable_counter_read(void)
+{
+    return (uint64_t)get_clock_ticks();
+}
+
+static inline uint64_t stable_counter_hz(void)
+{
+    return 1000;
+}
+
+#endif
+
+/*
+ * split to second and the remain, not overflow for long time
+ */
+static inline uint64_t stable_counter_to_us(uint64_t count)
+{
+    uint64_t hz = stable_counter_hz();
+
+    return count / hz * 1000000ULL + count % hz * 1000000ULL / hz;
+}
+
+static inline uint64_t stable_counter_to_ns(uint64_t count)
+{
+    uint64_t hz = stable_counter_hz();
+
+    return count / hz * 1000000000ULL + count % hz * 1000000000ULL / hz;
+}
+
+static inline uint64_t stable_counter_from_us(uint64_t us)
+{
+    return us * stable_counter_hz() / 1000000ULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _STABLE_COUNTER_H
+
+/*
+ * @@ END
+ */
@@ -1,681 +1,1668 @@
-﻿/*
- * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
- *
- */
-
-/**
- * memory manager posix api implement
- */
-
-#include "bsp.h"
-
-#if !BSP_USE_FS
-
-#include <stdint.h>
-#include <stdlib.h>
-#include <string.h>
-
-#if defined(OS_RTTHREAD)
-#include "rtthread.h"
-#elif defined(OS_FREERTOS)
-#include "FreeRTOS.h"
-#else // uCOSIII && OS_PESUDO
-#include "osal.h"
-#endif
-
-#if defined(OS_RTTHREAD)
-
-//-----------------------------------------------------------------------------
-// RTThread
-//-----------------------------------------------------------------------------
-
-void *malloc(size_t size)
-{
-    return rt_malloc(size);
-}
-
-void *calloc(size_t nmemb, size_t size)
-{
-    return rt_calloc(nmemb, size);
-}
-
-void free(void *ptr)
-{
-    rt_free(ptr);
-}
-
-#elif defined(OS_FREERTOS)
-
-//-----------------------------------------------------------------------------
-// FreeRTOS
-//-----------------------------------------------------------------------------
-
-#include "FreeRTOS.h"
-
-void *malloc(size_t size)
-{
-    return pvPortMalloc(size);
-}
-
-void *calloc(size_t nmemb, size_t size)
-{
-    void *ptr = pvPortMalloc(nmemb * size);
-
-    if (ptr)
-    {
-        memset(ptr, 0x00, nmemb * size);
-    }
-
-    return ptr;
-}
-
-void free(void *ptr)
-{
-    vPortFree(ptr);
-}
-
-#else
-
-//-----------------------------------------------------------------------------
-// BareMetal && uCOSIII
-//-----------------------------------------------------------------------------
-
-#include "osal.h"
-
-extern void printk(const char *fmt, ...);
-
-//-----------------------------------------------------------------------------
-
-#ifndef align_up
-#define align_up(num, align)    (((num) + ((align)-1)) & ~((align)-1))
-#endif
-
-/**
- * memory block node struct
- */
-typedef struct blk_node
-{
-    unsigned int     flag;                  /* =1: used; =0: blank */
-	unsigned int     size;
-	void            *block;
-    struct blk_node *prev;
-    struct blk_node *next;
-} blk_node_t;
-
-#define BLOCK_NODE_SZ       (align_up(sizeof(blk_node_t), 8))
-
-#define BLOCK_USED_FLAG     (0xdeadbeaf)
-
-#define ALLOC_ALIGNMENT     (sizeof(void *))    /* malloc buffer align 8 bytes */
-
-#define ALLOC_MIN_BYTES     32                  /* min malloc size */
-
-//-----------------------------------------------------------------------------
-
-#define INFO_NODE(node, i) { \
-    printk("  Faulty block[%i] @0x%016lx\r\n", i, (long)node); \
-    printk("    flag  = 0x%08x\r\n", node->flag); \
-    printk("    size  = 0x%08x\r\n", node->size); \
-    printk("    block = 0x%016lx\r\n", (long)node->block); \
-    printk("    prev  = 0x%016lx\r\n", (long)node->prev);  \
-    printk("    next  = 0x%016lx\r\n", (long)node->next); }
-
-/*
- * lock alloc with mutex support
- */
-static osal_mutex_t p_alloc_mutex = NULL;
-
-//-----------------------------------------------------------------------------
-// free memory queue head
-//-----------------------------------------------------------------------------
-
-static blk_node_t *heap_list_head = NULL;
-
-static size_t heap_total_bytes  = 0;
-static size_t heap_remain_bytes = 0;
-
-//-----------------------------------------------------------------------------
-
-int heap_verify_faulty_blocks(void)
-{
-    blk_node_t *node = heap_list_head, *prev, *next;
-    int count = 0, i = 0;
-
-    printk("Verify heap blocks:\r\n");
-
-    while (node)
-    {
-        prev = node->prev;
-        next = node->next;
-
-        /*
-         * Self is correct
-         */
-        if ((size_t)node + BLOCK_NODE_SZ != (size_t)node->block)
-        {
-            count++;
-            if (osal_is_osrunning())
-            {
-                INFO_NODE(node, i);
-            }
-            break;
-        }
-
-        /*
-         * Previous is correct
-         */
-        if (prev && ((size_t)prev + BLOCK_NODE_SZ + prev->size != (size_t)node))
-        {
-            count++;
-            if (osal_is_osrunning())
-            {
-                INFO_NODE(node, i);
-            }
-            break;
-        }
-
-        /*
-         * Next is correct
-         */
-        if (next && ((size_t)node + BLOCK_NODE_SZ + node->size != (size_t)next))
-        {
-            count++;
-            if (osal_is_osrunning())
-            {
-                INFO_NODE(node, i);
-            }
-            break;
-        }
-
-        i++;
-        node = node->next;
-    }
-
-    if (count == 0)
-    {
-        printk("Not found any fault block\r\n");
-    }
-
-    return -count;
-}
-
-int heap_view_isolated_blocks(void)
-{
-    blk_node_t *node = heap_list_head;
-    int count = 0;
-
-    printk("Seek isolated blocks:\r\n");
-
-    while (node)
-    {
-        if (node->prev && node->next && (node->flag == 0))
-        {
-            count++;
-            printk("  block @0x%016lx, size = %iB\r\n", (long)node, node->size);
-        }
-
-        node = node->next;
-    }
-
-    printk("Total %i isolated blocks\r\n", count);
-
-    return count;
-}
-
-//-----------------------------------------------------------------------------
-// OS lock
-//-----------------------------------------------------------------------------
-
-void malloc_create_oslock(void)
-{
-    if (!p_alloc_mutex)
-    {
-        p_alloc_mutex = osal_mutex_create("heap_loc", OSAL_OPT_FIFO);
-    }
-}
-
-static void malloc_oslock()
-{
-    if (osal_is_osrunning())
-    {
-        osal_mutex_obtain(p_alloc_mutex, OSAL_WAIT_FOREVER);
-    }
-}
-
-static void malloc_osunlock()
-{
-    if (osal_is_osrunning())
-    {
-        osal_mutex_release(p_alloc_mutex);
-    }
-}
-
-//-----------------------------------------------------------------------------
-// add heap addrss & size. Only can add once
-//-----------------------------------------------------------------------------
-
-int heap_add_region(void *addr, size_t size)
-{
-    unsigned char *first_addr;
-
-    if (!addr || (size < 0x100000) || heap_list_head)
-    {
-        return -1;
-    }
-
-    first_addr = (unsigned char *)align_up((size_t)addr, ALLOC_ALIGNMENT);
-
-    heap_list_head = (blk_node_t *)first_addr;
-    heap_list_head->block = (void *)(first_addr + BLOCK_NODE_SZ);
-
-    size &= ~(ALLOC_ALIGNMENT - 1);
-    heap_total_bytes = size - BLOCK_NODE_SZ;
-    heap_remain_bytes = heap_total_bytes;
-
-    heap_list_head->size = heap_total_bytes;
-    heap_list_head->flag = 0;
-    heap_list_head->prev = NULL;
-    heap_list_head->next = NULL;
-
-    return 0;
-}
-
-//-----------------------------------------------------------------------------
-
-void dump_heap_list(void)
-{
-    int i = 0;
-    blk_node_t *node = heap_list_head;
-
-    while (node)
-    {
-        INFO_NODE(node, i);
-
-        i++;
-        node = node->next;
-    }
-}
-
-size_t get_heap_size(void)
-{
-    return heap_total_bytes;
-}
-
-size_t get_heap_free_size(void)
-{
-    return heap_remain_bytes;
-}
-
-//-----------------------------------------------------------------------------
-// malloc() function
-//-----------------------------------------------------------------------------
-
-void *malloc(size_t size)
-{
-	blk_node_t *found_node = heap_list_head, *new_node = NULL;
-
-	if (size <= 0)
-    {
-        return NULL;
-    }
-
-    if (size <= ALLOC_MIN_BYTES)
-    {
-        size = ALLOC_MIN_BYTES;
-    }
-    else
-    {
-        size = align_up(size, ALLOC_ALIGNMENT);
-    }
-
-    malloc_oslock();
-
-    /*
-     * search a free block, Only match the first. TODO optimal match
-     */
-    while (found_node)
-    {
-        if ((found_node->flag == 0) && (found_node->size >= size + BLOCK_NODE_SZ))
-        {
-            break;
-        }
-
-        found_node = found_node->next;
-    }
-
-    if (!found_node)
-    {
-        malloc_osunlock();
-        return NULL;
-    }
-
-    /*
-     * if found_block's remain size less than ALLOC_MIN_BYTES + BLOCK_NODE_SZ,
-     * then use found_block directly.
-     */
-    if ((found_node->size - (size + BLOCK_NODE_SZ)) < (ALLOC_MIN_BYTES + BLOCK_NODE_SZ))
-    {
-        found_node->flag = BLOCK_USED_FLAG;
-
-        heap_remain_bytes -= found_node->size + BLOCK_NODE_SZ;
-        malloc_osunlock();
-        return found_node->block;
-    }
-
-	/*
-     * found block:
-     *   ------------------------------------------------------------------
-     *  |H| block, size >= size + NODE_HEAD_SZ                             |
-     *   ------------------------------------------------------------------
-     *
-     * after split:
-     *   ---------------|--------------------------------------------------
-     *  | found node    | new node                                         |
-     *  |H| block       |H| block                                          |
-     *   ---------------|--------------------------------------------------
-     *
-     * memory physical address: low -→high
-     *
-     */
-
-	new_node = (blk_node_t *)((size_t)found_node->block + size);
-	new_node->flag  = 0;
-	new_node->block = (unsigned char *)new_node + BLOCK_NODE_SZ;
-	new_node->size  = found_node->size - size - BLOCK_NODE_SZ;
-
-    found_node->flag = BLOCK_USED_FLAG;
-    found_node->size = size;
-
-	/*
-     * list:
-     *
-     *                   found_node           new_node
-     *               -→ ----------       -→ ----------       -→... next
-     *             ↗ _ | prev     |    ↗ _ | prev     |    ↗ _     node
-     *           ↗ ↙  |          |  ↗ ↙  |          |  ↗ ↙
-     * prev ...↗ ↙    |     next |↗ ↙    |     next |↗ ↙
-     * node ... ↙      |          |.↙      |          |.↙
-     *                  |          |         |          |
-     *                   ----------           ----------
-     *
-     * new_block has free memory to alloc more
-     */
-
-    new_node->prev = found_node;
-    new_node->next = found_node->next;
-    if (found_node->next)
-        found_node->next->prev = new_node;
-
-    found_node->next = new_node;
-
-    heap_remain_bytes -= size + BLOCK_NODE_SZ;
-	malloc_osunlock();
-
-	return found_node->block;
-}
-
-//-----------------------------------------------------------------------------
-// free() function
-//-----------------------------------------------------------------------------
-
-void free(void *ptr)
-{
-    blk_node_t *found_node = heap_list_head, *prev, *next;
-
-    if (!ptr)
-    {
-        return;
-    }
-
-    /*
-     * search for match block
-     */
-    while (found_node)
-    {
-        if ((found_node->flag == BLOCK_USED_FLAG) && (found_node->block == ptr))
-            break;
-
-        found_node = found_node->next;
-    }
-
-    if (!found_node)
-    {
-        if (osal_is_osrunning())
-        {
-            printk("fatal error: free memory @0x%016lx\r\n", (long)ptr);
-        }
-        return;
-    }
-
-	/*
-     * list:
-     *
-     *               prev node            found node           next node
-     *           -→ ----------       -→ ----------       -→ ----------       -→
-     *         ↗ _ | prev     |    ↗ _ | prev     |    ↗ _ | prev     |    ↗ _ ...
-     *       ↗ ↙  |          |  ↗ ↙  |          |  ↗ ↙  |          |  ↗ ↙
-     *     ↗ ↙    |     next |↗ ↙    |     next |↗ ↙    |     next |↗ ↙
-     *  ... ↙      |          |.↙      |          |.↙      |          |.↙
-     *              |          |         |          |         |          |
-     *               ----------           ----------           ----------
-     *
-     */
-
-	/*
-     * memory physical address: low -→high
-     *
-     *   ----------------|---------------|---------------------------------
-     *  | prev node      | found node    | next node                       |
-     *  |H| block        |H| block       |H| block                         |
-     *   ----------------|---------------|---------------------------------
-     *
-     */
-
-	malloc_oslock();
-
-    heap_remain_bytes += found_node->size + BLOCK_NODE_SZ;
-    found_node->flag = 0;
-
-    prev = found_node->prev;
-    next = found_node->next;
-
-    /*
-     * Combine previous block node
-     */
-    while (prev && (prev->flag == 0))
-    {
-        prev->size += found_node->size + BLOCK_NODE_SZ;
-        prev->next = found_node->next;
-        if (found_node->next)
-            found_node->next->prev = prev;
-
-        found_node = prev;
-        prev = found_node->prev;
-    }
-
-    /*
-     * Combine next block node
-     */
-    while (next && (next->flag == 0))
-    {
-        found_node->size += next->size + BLOCK_NODE_SZ;
-        next = next->next;
-        found_node->next = next;
-        if (next)
-            next->prev = found_node;
-    }
-
-    malloc_osunlock();
-}
-
-//-----------------------------------------------------------------------------
-// calloc() function
-//-----------------------------------------------------------------------------
-
-void *calloc(size_t nmemb, size_t size)
-{
-    void *ptr = malloc(nmemb * size);
-
-    if (ptr)
-    {
-        memset(ptr, 0x00, nmemb * size);
-    }
-
-    return ptr;
-}
-
-#endif // OS Functions
-
-//-----------------------------------------------------------------------------
-
-//-----------------------------------------------------------------------------
-// realloc() function
-//-----------------------------------------------------------------------------
-
-#ifdef OS_RTTHREAD
-
-void *realloc(void *ptr, size_t size)
-{
-    return rt_realloc(ptr, size);
-}
-
-void *aligned_malloc(size_t size, unsigned int align)
-{
-    return rt_malloc_align((rt_size_t)size, (rt_size_t)align);
-}
-
-void aligned_free(void *addr)
-{
-    rt_free_align(addr);
-}
-
-#else
-
-void *realloc(void *ptr, size_t size)
-{
-    if (size <= 0)
-    {
-        return NULL;
-    }
-
-    void *newptr = malloc(size);
-    
-    if (newptr)
-    {
-        if (ptr)
-        {
-            memcpy(newptr, ptr, size);
-            free(ptr);
-        }
-
-        return newptr;
-    }
-
-    if (ptr)
-    {
-        free(ptr);      // 如果没有申请到内存, 是否释放?
-    }
-
-    return NULL;
-}
-
-//-----------------------------------------------------------------------------
-// aligned_malloc() function
-//-----------------------------------------------------------------------------
-
-void *aligned_malloc(size_t size, unsigned int align)
-{
-    void *head;
-    void **addr=NULL;
-
-    if ((size <= 0) || (align == 0))
-    {
-        return NULL;
-    }
-
-    align = (align + 7) & ~0x7;     // atleast aligned 8
-
-    head = (void *)malloc(size + align - 1 + sizeof(void *));
-
-    if (head == NULL)
-    {
-        return NULL;
-    }
-
-    size_t i = (size_t)head + sizeof(void *);
-
-    while (i < (size_t)head + sizeof(void *) + align - 1)
-    {
-        if  (i % align == 0)
-        {
-            addr = (void **)i;
-            break;
-        }
-
-        i++;
-    }
-
-    if (addr)
-    {
-        addr[-1] = head;
-    }
-
-    return addr;
-}
-
-//-----------------------------------------------------------------------------
-// aligned_free() function
-//-----------------------------------------------------------------------------
-
-void aligned_free(void *addr)
-{
-    if (addr)
-    {
-        void *ptr = ((void **)addr)[-1];
-        free(ptr);
-    }
-}
-
-#endif // #ifdef OS_RTTHREAD
-
-//-----------------------------------------------------------------------------
-// aligned_realloc() function
-//-----------------------------------------------------------------------------
-
-void *aligned_realloc(void *ptr, size_t size, unsigned int align)
-{
-    if (size <= 0)
-    {
-        return NULL;
-    }
-
-    void *newptr = aligned_malloc(size, align);
-
-    if (newptr)
-    {
-        if (ptr)
-        {
-            memcpy(newptr, ptr, size);
-
-            aligned_free(ptr);
-        }
-
-        return newptr;
-    }
-
-    if (ptr)
-    {
-        aligned_free(ptr);      // 如果没有申请到内存, 是否释放?
-    }
-
-    return NULL;
-}
-
-//-----------------------------------------------------------------------------
-
-#endif // #if !BSP_USE_FS
-
-/*
- * @@ END
- */
-
+﻿/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+
+/**
+ * memory manager posix api implement
+ */
+
+#include "bsp.h"
+
+#if !BSP_USE_FS
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memory_man.h"
+
+#if defined(OS_RTTHREAD)
+#include "rtthread.h"
+#elif defined(OS_FREERTOS)
+#include "FreeRTOS.h"
+#else // uCOSIII && OS_PESUDO
+#include "osal.h"
+#endif
+
+#if defined(OS_RTTHREAD)
+
+//-----------------------------------------------------------------------------
+// RTThread
+//-----------------------------------------------------------------------------
+
+void *malloc(size_t size)
+{
+    return rt_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    return rt_calloc(nmemb, size);
+}
+
+void free(void *ptr)
+{
+    rt_free(ptr);
+}
+
+#elif defined(OS_FREERTOS)
+
+//-----------------------------------------------------------------------------
+// FreeRTOS
+//-----------------------------------------------------------------------------
+
+#include "FreeRTOS.h"
+
+void *malloc(size_t size)
+{
+    return pvPortMalloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    void *ptr = pvPortMalloc(nmemb * size);
+
+    if (ptr)
+    {
+        memset(ptr, 0x00, nmemb * size);
+    }
+
+    return ptr;
+}
+
+void free(void *ptr)
+{
+    vPortFree(ptr);
+}
+
+#else
+
+//-----------------------------------------------------------------------------
+// BareMetal && uCOSIII
+//-----------------------------------------------------------------------------
+
+#include "osal.h"
+#include "stable_counter.h"
+
+#if defined(OS_PESUDO)
+#include "pesudoos.h"
+#include "pesudo_task.h"
+
+#define HEAP_TRACE_TASK_ID() \
+    (current_pesudo_task ? (uint16_t)current_pesudo_task->ID : HEAP_TRACE_NO_TASK)
+#else
+#define HEAP_TRACE_TASK_ID()    HEAP_TRACE_NO_TASK
+#endif
+
+extern void printk(const char *fmt, ...);
+extern int fls(int x);
+
+//-----------------------------------------------------------------------------
+
+#ifndef align_up
+#define align_up(num, align)    (((num) + ((align)-1)) & ~((align)-1))
+#endif
+
+/**
+ * memory block node struct
+ *
+ * prev/next link the blocks by physical address, the node header is always
+ * located just before the block, so free() find it in constant time.
+ */
+typedef struct blk_node
+{
+    unsigned int     flag;                  /* =BLOCK_USED_FLAG: used; =0: blank */
+	unsigned int     size;
+    unsigned short   tag;                   /* HEAP_TAG_XXX when allocated */
+    unsigned short   cls;                   /* HEAP_CLASS_XXX of the region */
+	void            *block;
+    struct blk_node *prev;
+    struct blk_node *next;
+} blk_node_t;
+
+/**
+ * blank block is linked to the segregated free list, the links are stored
+ * in the block itself, so the node header keep small.
+ */
+typedef struct free_link
+{
+    blk_node_t *prev_free;
+    blk_node_t *next_free;
+} free_link_t;
+
+#define FREE_LINK(node)     ((free_link_t *)(node)->block)
+
+#define BLOCK_NODE_SZ       (align_up(sizeof(blk_node_t), 8))
+
+#define BLOCK_USED_FLAG     (0xdeadbeaf)
+
+#define ALLOC_ALIGNMENT     (sizeof(void *))    /* malloc buffer align 8 bytes */
+
+#define ALLOC_MIN_BYTES     32                  /* min malloc size, >= sizeof(free_link_t) */
+
+/*
+ * TLSF: two level segregated fit
+ *
+ *   first level:  power of 2 size class, fls(size)
+ *   second level: split each first level class into TLSF_SL_COUNT lists
+ *
+ *   block < TLSF_SMALL_SIZE all go to first level 0, linear by 8 bytes.
+ */
+#define TLSF_SL_LOG2        4
+#define TLSF_SL_COUNT       (1 << TLSF_SL_LOG2)                 /* 16 */
+#define TLSF_ALIGN_LOG2     3                                   /* ALLOC_ALIGNMENT */
+#define TLSF_FL_SHIFT       (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_SIZE     (1 << TLSF_FL_SHIFT)                /* 128 */
+#define TLSF_FL_COUNT       (32 - TLSF_FL_SHIFT + 1)            /* size is 32 bits */
+
+//-----------------------------------------------------------------------------
+
+#define INFO_NODE(node, i) { \
+    printk("  Faulty block[%i] @0x%016lx\r\n", i, (long)node); \
+    printk("    flag  = 0x%08x\r\n", node->flag); \
+    printk("    size  = 0x%08x\r\n", node->size); \
+    printk("    tag   = %u, class = %u\r\n", node->tag, node->cls); \
+    printk("    block = 0x%016lx\r\n", (long)node->block); \
+    printk("    prev  = 0x%016lx\r\n", (long)node->prev);  \
+    printk("    next  = 0x%016lx\r\n", (long)node->next); }
+
+/*
+ * lock alloc with mutex support
+ */
+static osal_mutex_t p_alloc_mutex = NULL;
+
+//-----------------------------------------------------------------------------
+// heap regions & classes
+//-----------------------------------------------------------------------------
+
+/*
+ * segregated free lists of one memory class, the regions of same class
+ * share it. Blocks of a region are linked by physical address, from head.
+ */
+typedef struct heap_ctrl
+{
+    uint32_t    fl_bitmap;
+    uint32_t    sl_bitmap[TLSF_FL_COUNT];
+    blk_node_t *free_list[TLSF_FL_COUNT][TLSF_SL_COUNT];
+    uint32_t    free_blocks;
+    size_t      total_bytes;
+    size_t      remain_bytes;
+} heap_ctrl_t;
+
+typedef struct heap_region
+{
+    blk_node_t  *head;                      /* first block */
+    size_t       end_addr;                  /* end of the last block */
+    unsigned int cls;
+} heap_region_t;
+
+static heap_ctrl_t   heap_ctrl[HEAP_CLASS_MAX];
+static heap_region_t heap_regions[HEAP_REGION_MAX];
+static int           heap_region_count = 0;
+
+/*
+ * all classes
+ */
+static size_t heap_total_bytes  = 0;
+static size_t heap_remain_bytes = 0;
+
+/*
+ * malloc_class() try the classes in this order
+ */
+static const unsigned char heap_class_order[HEAP_CLASS_MAX][HEAP_CLASS_MAX] =
+{
+    { HEAP_CLASS_FAST, HEAP_CLASS_BULK, HEAP_CLASS_DMA  },      /* FAST */
+    { HEAP_CLASS_DMA,  HEAP_CLASS_BULK, HEAP_CLASS_FAST },      /* DMA  */
+    { HEAP_CLASS_BULK, HEAP_CLASS_DMA,  HEAP_CLASS_FAST },      /* BULK */
+};
+
+/*
+ * statistics, updated with lock
+ */
+static heap_stats_t     heap_counter;               /* counters & histograms */
+static size_t           heap_peak_used = 0;
+static unsigned int     heap_cur_tag   = HEAP_TAG_NONE;
+static heap_tag_stats_t heap_tags[HEAP_TAG_MAX];
+
+//-----------------------------------------------------------------------------
+// TLSF helper
+//-----------------------------------------------------------------------------
+
+/*
+ * index of lowest set bit, x must not be 0
+ */
+static inline int tlsf_ffs(uint32_t x)
+{
+    return fls((int)(x & (~x + 1))) - 1;
+}
+
+/*
+ * size -→ list index, which the block of this size insert into
+ */
+static void tlsf_mapping_insert(size_t size, int *fl, int *sl)
+{
+    if (size < TLSF_SMALL_SIZE)
+    {
+        *fl = 0;
+        *sl = (int)size / (TLSF_SMALL_SIZE / TLSF_SL_COUNT);
+    }
+    else
+    {
+        int f = fls((int)size) - 1;
+
+        *sl = (int)(size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+        *fl = f - (TLSF_FL_SHIFT - 1);
+    }
+}
+
+/*
+ * size -→ list index, which every block is big enough for this size
+ */
+static void tlsf_mapping_search(size_t size, int *fl, int *sl)
+{
+    if (size >= TLSF_SMALL_SIZE)
+    {
+        size += (1 << (fls((int)size) - 1 - TLSF_SL_LOG2)) - 1;
+    }
+
+    tlsf_mapping_insert(size, fl, sl);
+}
+
+static blk_node_t *tlsf_find_suitable(heap_ctrl_t *ctrl, int *fl, int *sl)
+{
+    uint32_t sl_map, fl_map;
+
+    if (*fl >= TLSF_FL_COUNT)
+    {
+        return NULL;
+    }
+
+    sl_map = ctrl->sl_bitmap[*fl] & (~0U << *sl);
+
+    if (!sl_map)
+    {
+        /*
+         * search next bigger first level
+         */
+        fl_map = ctrl->fl_bitmap & (~0U << (*fl + 1));
+        if (!fl_map)
+        {
+            return NULL;
+        }
+
+        *fl = tlsf_ffs(fl_map);
+        sl_map = ctrl->sl_bitmap[*fl];
+    }
+
+    *sl = tlsf_ffs(sl_map);
+
+    return ctrl->free_list[*fl][*sl];
+}
+
+static void tlsf_insert(blk_node_t *node)
+{
+    int fl, sl;
+    heap_ctrl_t *ctrl = &heap_ctrl[node->cls];
+    free_link_t *link = FREE_LINK(node);
+
+    tlsf_mapping_insert(node->size, &fl, &sl);
+
+    link->prev_free = NULL;
+    link->next_free = ctrl->free_list[fl][sl];
+    if (link->next_free)
+        FREE_LINK(link->next_free)->prev_free = node;
+
+    ctrl->free_list[fl][sl] = node;
+    ctrl->fl_bitmap     |= 1U << fl;
+    ctrl->sl_bitmap[fl] |= 1U << sl;
+
+    ctrl->free_blocks++;
+}
+
+static void tlsf_remove(blk_node_t *node)
+{
+    int fl, sl;
+    heap_ctrl_t *ctrl = &heap_ctrl[node->cls];
+    free_link_t *link = FREE_LINK(node);
+
+    tlsf_mapping_insert(node->size, &fl, &sl);
+
+    if (link->prev_free)
+        FREE_LINK(link->prev_free)->next_free = link->next_free;
+    if (link->next_free)
+        FREE_LINK(link->next_free)->prev_free = link->prev_free;
+
+    if (ctrl->free_list[fl][sl] == node)
+    {
+        ctrl->free_list[fl][sl] = link->next_free;
+
+        if (!link->next_free)
+        {
+            ctrl->sl_bitmap[fl] &= ~(1U << sl);
+            if (!ctrl->sl_bitmap[fl])
+                ctrl->fl_bitmap &= ~(1U << fl);
+        }
+    }
+
+    ctrl->free_blocks--;
+}
+
+/*
+ * free bytes change, of the class and all
+ */
+static inline void heap_remain_add(unsigned int cls, long delta)
+{
+    heap_ctrl[cls].remain_bytes += delta;
+    heap_remain_bytes += delta;
+}
+
+/*
+ * the node header of a malloc() pointer, NULL if not a used block
+ */
+static blk_node_t *block_to_node(void *ptr)
+{
+    blk_node_t *node = (blk_node_t *)((size_t)ptr - BLOCK_NODE_SZ);
+    int i;
+
+    if ((size_t)ptr & (ALLOC_ALIGNMENT - 1))
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < heap_region_count; i++)
+    {
+        if (((size_t)node >= (size_t)heap_regions[i].head) &&
+            ((size_t)ptr < heap_regions[i].end_addr))
+        {
+            break;
+        }
+    }
+
+    if (i >= heap_region_count)
+    {
+        return NULL;
+    }
+
+    if ((node->flag != BLOCK_USED_FLAG) || (node->block != ptr))
+    {
+        return NULL;
+    }
+
+    return node;
+}
+
+//-----------------------------------------------------------------------------
+
+int heap_verify_faulty_blocks(void)
+{
+    blk_node_t *node, *prev, *next;
+    int count = 0, i = 0, r;
+
+    printk("Verify heap blocks:\r\n");
+
+    for (r = 0; (r < heap_region_count) && (count == 0); r++)
+    {
+        for (node = heap_regions[r].head; node; node = node->next, i++)
+        {
+            prev = node->prev;
+            next = node->next;
+
+            /*
+             * Self is correct
+             */
+            if (((size_t)node + BLOCK_NODE_SZ != (size_t)node->block) ||
+                ((node->flag != 0) && (node->flag != BLOCK_USED_FLAG)) ||
+                (node->cls != heap_regions[r].cls))
+            {
+                count++;
+                if (osal_is_osrunning())
+                {
+                    INFO_NODE(node, i);
+                }
+                break;
+            }
+
+            /*
+             * Previous is correct
+             */
+            if (prev && ((size_t)prev + BLOCK_NODE_SZ + prev->size != (size_t)node))
+            {
+                count++;
+                if (osal_is_osrunning())
+                {
+                    INFO_NODE(node, i);
+                }
+                break;
+            }
+
+            /*
+             * Next is correct
+             */
+            if (next && ((size_t)node + BLOCK_NODE_SZ + node->size != (size_t)next))
+            {
+                count++;
+                if (osal_is_osrunning())
+                {
+                    INFO_NODE(node, i);
+                }
+                break;
+            }
+
+            /*
+             * Blank block is in the free list
+             */
+            if (node->flag == 0)
+            {
+                int fl, sl;
+
+                tlsf_mapping_insert(node->size, &fl, &sl);
+
+                if ((FREE_LINK(node)->prev_free == NULL) &&
+                    (heap_ctrl[node->cls].free_list[fl][sl] != node))
+                {
+                    count++;
+                    if (osal_is_osrunning())
+                    {
+                        INFO_NODE(node, i);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    if (count == 0)
+    {
+        printk("Not found any fault block\r\n");
+    }
+
+    return -count;
+}
+
+int heap_view_isolated_blocks(void)
+{
+    blk_node_t *node;
+    int count = 0, r;
+
+    printk("Seek isolated blocks:\r\n");
+
+    for (r = 0; r < heap_region_count; r++)
+    {
+        for (node = heap_regions[r].head; node; node = node->next)
+        {
+            if (node->prev && node->next && (node->flag == 0))
+            {
+                count++;
+                printk("  block @0x%016lx, size = %iB\r\n", (long)node, node->size);
+            }
+        }
+    }
+
+    printk("Total %i isolated blocks\r\n", count);
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+// OS lock
+//-----------------------------------------------------------------------------
+
+void malloc_create_oslock(void)
+{
+    if (!p_alloc_mutex)
+    {
+        p_alloc_mutex = osal_mutex_create("heap_loc", OSAL_OPT_FIFO);
+    }
+}
+
+static void malloc_oslock()
+{
+    if (osal_is_osrunning())
+    {
+        /*
+         * 持有期间不会切换任务, 没有堆栈的任务调用也不会阻塞, 不做检查
+         */
+        (osal_mutex_obtain)(p_alloc_mutex, OSAL_WAIT_FOREVER);
+    }
+}
+
+static void malloc_osunlock()
+{
+    if (osal_is_osrunning())
+    {
+        osal_mutex_release(p_alloc_mutex);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// add heap addrss & size, at most HEAP_REGION_MAX regions
+//-----------------------------------------------------------------------------
+
+int heap_add_region_class(void *addr, size_t size, unsigned int cls)
+{
+    size_t first_addr, end_addr;
+    heap_region_t *region;
+    blk_node_t *head;
+    int i;
+
+    if (!addr || (cls >= HEAP_CLASS_MAX) || (size < HEAP_REGION_MIN) ||
+        (size > 0xFFFFFFFF) || (heap_region_count >= HEAP_REGION_MAX))
+    {
+        return -1;
+    }
+
+    first_addr = align_up((size_t)addr, ALLOC_ALIGNMENT);
+    end_addr   = ((size_t)addr + size) & ~(ALLOC_ALIGNMENT - 1);
+
+    /*
+     * overlap with added region
+     */
+    for (i = 0; i < heap_region_count; i++)
+    {
+        if ((first_addr < heap_regions[i].end_addr) &&
+            (end_addr > (size_t)heap_regions[i].head))
+        {
+            return -1;
+        }
+    }
+
+    malloc_oslock();
+
+    head = (blk_node_t *)first_addr;
+    head->block = (void *)(first_addr + BLOCK_NODE_SZ);
+    head->size  = end_addr - first_addr - BLOCK_NODE_SZ;
+    head->flag  = 0;
+    head->tag   = HEAP_TAG_NONE;
+    head->cls   = cls;
+    head->prev  = NULL;
+    head->next  = NULL;
+
+    region = &heap_regions[heap_region_count++];
+    region->head     = head;
+    region->end_addr = end_addr;
+    region->cls      = cls;
+
+    heap_ctrl[cls].total_bytes += head->size;
+    heap_total_bytes += head->size;
+    heap_remain_add(cls, head->size);
+
+    tlsf_insert(head);
+
+    malloc_osunlock();
+
+    return 0;
+}
+
+/*
+ * called by bsp with the whole free ram
+ */
+int heap_add_region(void *addr, size_t size)
+{
+    return heap_add_region_class(addr, size, HEAP_CLASS_BULK);
+}
+
+//-----------------------------------------------------------------------------
+
+void dump_heap_list(void)
+{
+    int i = 0, r;
+    blk_node_t *node;
+
+    for (r = 0; r < heap_region_count; r++)
+    {
+        printk("Region %i, class %u:\r\n", r, heap_regions[r].cls);
+
+        for (node = heap_regions[r].head; node; node = node->next)
+        {
+            INFO_NODE(node, i);
+
+            i++;
+        }
+    }
+}
+
+size_t get_heap_size(void)
+{
+    return heap_total_bytes;
+}
+
+size_t get_heap_free_size(void)
+{
+    return heap_remain_bytes;
+}
+
+int heap_class_size(unsigned int cls, size_t *total, size_t *free_bytes)
+{
+    if (cls >= HEAP_CLASS_MAX)
+    {
+        return -1;
+    }
+
+    if (total)
+        *total = heap_ctrl[cls].total_bytes;
+    if (free_bytes)
+        *free_bytes = heap_ctrl[cls].remain_bytes;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// statistics
+//-----------------------------------------------------------------------------
+
+static inline int stats_bucket(uint64_t cycles)
+{
+    int i = fls((int)(cycles > 0x7FFFFFFF ? 0x7FFFFFFF : cycles));
+
+    return i >= HEAP_HIST_BUCKETS ? HEAP_HIST_BUCKETS - 1 : i;
+}
+
+static void stats_record(uint32_t *hist, uint32_t *max, uint64_t cycles)
+{
+    hist[stats_bucket(cycles)]++;
+
+    if (cycles > *max)
+    {
+        *max = cycles > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)cycles;
+    }
+}
+
+/*
+ * block become used, or used block change size
+ */
+static void stats_account(blk_node_t *node, long delta, int blocks)
+{
+    heap_tag_stats_t *tag = &heap_tags[node->tag];
+    size_t used = heap_total_bytes - heap_remain_bytes;
+
+    if (used > heap_peak_used)
+    {
+        heap_peak_used = used;
+    }
+
+    tag->used_bytes += delta;
+    tag->blocks += blocks;
+    if (tag->used_bytes > tag->peak_bytes)
+    {
+        tag->peak_bytes = tag->used_bytes;
+    }
+}
+
+/*
+ * largest blank block, in the highest non-empty list
+ */
+static size_t tlsf_largest_free(heap_ctrl_t *ctrl)
+{
+    blk_node_t *node;
+    size_t largest = 0;
+    int fl, sl;
+
+    if (!ctrl->fl_bitmap)
+    {
+        return 0;
+    }
+
+    fl = fls((int)ctrl->fl_bitmap) - 1;
+    sl = fls((int)ctrl->sl_bitmap[fl]) - 1;
+
+    for (node = ctrl->free_list[fl][sl]; node; node = FREE_LINK(node)->next_free)
+    {
+        if (node->size > largest)
+            largest = node->size;
+    }
+
+    return largest;
+}
+
+int heap_stats(heap_stats_t *stats)
+{
+    size_t free_bytes, largest;
+    unsigned int cls;
+
+    if (!stats)
+    {
+        return -1;
+    }
+
+    malloc_oslock();
+
+    *stats = heap_counter;
+
+    free_bytes = heap_remain_bytes;
+
+    stats->total_bytes        = heap_total_bytes;
+    stats->free_bytes         = free_bytes;
+    stats->peak_used_bytes    = heap_peak_used;
+    stats->largest_free_block = 0;
+    stats->free_block_count   = 0;
+
+    for (cls = 0; cls < HEAP_CLASS_MAX; cls++)
+    {
+        largest = tlsf_largest_free(&heap_ctrl[cls]);
+        if (largest > stats->largest_free_block)
+            stats->largest_free_block = largest;
+
+        stats->free_block_count += heap_ctrl[cls].free_blocks;
+    }
+    stats->fragmentation      = free_bytes ?
+        (uint32_t)(1000 - (uint64_t)stats->largest_free_block * 1000 / free_bytes) : 0;
+
+    malloc_osunlock();
+
+    return 0;
+}
+
+void heap_stats_reset(void)
+{
+    malloc_oslock();
+
+    memset(&heap_counter, 0, sizeof(heap_counter));
+    heap_peak_used = heap_total_bytes - heap_remain_bytes;
+
+    malloc_osunlock();
+}
+
+void heap_stats_show(void)
+{
+    heap_stats_t st;
+    heap_tag_stats_t tag;
+    unsigned int i;
+
+    if (heap_stats(&st) != 0)
+    {
+        return;
+    }
+
+    printk("Heap: total %lu, free %lu, peak used %lu\r\n",
+           (long)st.total_bytes, (long)st.free_bytes, (long)st.peak_used_bytes);
+    printk("  largest free %lu, free blocks %u, fragmentation %u.%u%%\r\n",
+           (long)st.largest_free_block, st.free_block_count,
+           st.fragmentation / 10, st.fragmentation % 10);
+
+    for (i = 0; i < HEAP_CLASS_MAX; i++)
+    {
+        if (heap_ctrl[i].total_bytes)
+        {
+            printk("  class %u: total %lu, free %lu\r\n", i,
+                   (long)heap_ctrl[i].total_bytes, (long)heap_ctrl[i].remain_bytes);
+        }
+    }
+    printk("  malloc %u (fail %u), max %u us; free %u, max %u us\r\n",
+           st.alloc_count, st.fail_count, (unsigned)stable_counter_to_us(st.alloc_max_cycles),
+           st.free_count, (unsigned)stable_counter_to_us(st.free_max_cycles));
+
+    printk("  latency(cycles)   malloc       free\r\n");
+    for (i = 0; i < HEAP_HIST_BUCKETS; i++)
+    {
+        if (st.alloc_hist[i] || st.free_hist[i])
+        {
+            printk("    < %-10u  %10u %10u\r\n", 1U << i, st.alloc_hist[i], st.free_hist[i]);
+        }
+    }
+
+    printk("  tag     used       peak     budget  blocks\r\n");
+    for (i = 0; i < HEAP_TAG_MAX; i++)
+    {
+        if ((heap_tag_stats(i, &tag) == 0) && (tag.peak_bytes || tag.budget_bytes))
+        {
+            printk("    %u %10lu %10lu %10lu %7u%s\r\n", i,
+                   (long)tag.used_bytes, (long)tag.peak_bytes, (long)tag.budget_bytes, tag.blocks,
+                   (tag.budget_bytes && (tag.peak_bytes > tag.budget_bytes)) ? "  over budget" : "");
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// allocation tag
+//-----------------------------------------------------------------------------
+
+unsigned int heap_set_tag(unsigned int tag)
+{
+    unsigned int prev = heap_cur_tag;
+
+    if (tag < HEAP_TAG_MAX)
+    {
+        heap_cur_tag = tag;
+    }
+
+    return prev;
+}
+
+void heap_set_tag_budget(unsigned int tag, size_t bytes)
+{
+    if (tag < HEAP_TAG_MAX)
+    {
+        heap_tags[tag].budget_bytes = bytes;
+    }
+}
+
+int heap_tag_stats(unsigned int tag, heap_tag_stats_t *stats)
+{
+    if ((tag >= HEAP_TAG_MAX) || !stats)
+    {
+        return -1;
+    }
+
+    malloc_oslock();
+    *stats = heap_tags[tag];
+    malloc_osunlock();
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// alloc & free a block, must be called with lock
+//-----------------------------------------------------------------------------
+
+/*
+ * size is aligned already
+ */
+static blk_node_t *heap_alloc_block(size_t size, unsigned int cls)
+{
+	blk_node_t *found_node, *new_node;
+    int fl, sl;
+
+    /*
+     * search a free list which all blocks are big enough, good fit and O(1)
+     */
+    tlsf_mapping_search(size, &fl, &sl);
+    found_node = tlsf_find_suitable(&heap_ctrl[cls], &fl, &sl);
+
+    if (!found_node)
+    {
+        return NULL;
+    }
+
+    tlsf_remove(found_node);
+
+    found_node->flag = BLOCK_USED_FLAG;
+    found_node->tag  = heap_cur_tag;
+
+    /*
+     * if found_block's remain size less than ALLOC_MIN_BYTES + BLOCK_NODE_SZ,
+     * then use found_block directly.
+     */
+    if ((found_node->size - size) < (ALLOC_MIN_BYTES + BLOCK_NODE_SZ))
+    {
+        heap_remain_add(cls, -(long)(found_node->size + BLOCK_NODE_SZ));
+        stats_account(found_node, found_node->size, 1);
+        return found_node;
+    }
+
+	/*
+     * found block:
+     *   ------------------------------------------------------------------
+     *  |H| block, size >= size + NODE_HEAD_SZ                             |
+     *   ------------------------------------------------------------------
+     *
+     * after split:
+     *   ---------------|--------------------------------------------------
+     *  | found node    | new node                                         |
+     *  |H| block       |H| block                                          |
+     *   ---------------|--------------------------------------------------
+     *
+     * memory physical address: low -→high
+     *
+     */
+
+	new_node = (blk_node_t *)((size_t)found_node->block + size);
+	new_node->flag  = 0;
+	new_node->cls   = cls;
+	new_node->block = (unsigned char *)new_node + BLOCK_NODE_SZ;
+	new_node->size  = found_node->size - size - BLOCK_NODE_SZ;
+
+    found_node->size = size;
+
+	/*
+     * list:
+     *
+     *                   found_node           new_node
+     *               -→ ----------       -→ ----------       -→... next
+     *             ↗ _ | prev     |    ↗ _ | prev     |    ↗ _     node
+     *           ↗ ↙  |          |  ↗ ↙  |          |  ↗ ↙
+     * prev ...↗ ↙    |     next |↗ ↙    |     next |↗ ↙
+     * node ... ↙      |          |.↙      |          |.↙
+     *                  |          |         |          |
+     *                   ----------           ----------
+     *
+     * new_block has free memory to alloc more
+     */
+
+    new_node->prev = found_node;
+    new_node->next = found_node->next;
+    if (found_node->next)
+        found_node->next->prev = new_node;
+
+    found_node->next = new_node;
+
+    tlsf_insert(new_node);
+
+    heap_remain_add(cls, -(long)(size + BLOCK_NODE_SZ));
+    stats_account(found_node, size, 1);
+
+	return found_node;
+}
+
+static void heap_free_block(blk_node_t *found_node)
+{
+    blk_node_t *prev, *next;
+
+	/*
+     * list:
+     *
+     *               prev node            found node           next node
+     *           -→ ----------       -→ ----------       -→ ----------       -→
+     *         ↗ _ | prev     |    ↗ _ | prev     |    ↗ _ | prev     |    ↗ _ ...
+     *       ↗ ↙  |          |  ↗ ↙  |          |  ↗ ↙  |          |  ↗ ↙
+     *     ↗ ↙    |     next |↗ ↙    |     next |↗ ↙    |     next |↗ ↙
+     *  ... ↙      |          |.↙      |          |.↙      |          |.↙
+     *              |          |         |          |         |          |
+     *               ----------           ----------           ----------
+     *
+     */
+
+	/*
+     * memory physical address: low -→high
+     *
+     *   ----------------|---------------|---------------------------------
+     *  | prev node      | found node    | next node                       |
+     *  |H| block        |H| block       |H| block                         |
+     *   ----------------|---------------|---------------------------------
+     *
+     */
+
+    heap_remain_add(found_node->cls, found_node->size + BLOCK_NODE_SZ);
+    stats_account(found_node, -(long)found_node->size, -1);
+    found_node->flag = 0;
+
+    prev = found_node->prev;
+    next = found_node->next;
+
+    /*
+     * Combine previous block node. Blank blocks never adjoin each other,
+     * so only one neighbour at each side need to check.
+     */
+    if (prev && (prev->flag == 0))
+    {
+        tlsf_remove(prev);
+
+        prev->size += found_node->size + BLOCK_NODE_SZ;
+        prev->next = next;
+        if (next)
+            next->prev = prev;
+
+        found_node = prev;
+    }
+
+    /*
+     * Combine next block node
+     */
+    if (next && (next->flag == 0))
+    {
+        tlsf_remove(next);
+
+        found_node->size += next->size + BLOCK_NODE_SZ;
+        found_node->next = next->next;
+        if (next->next)
+            next->next->prev = found_node;
+    }
+
+    tlsf_insert(found_node);
+}
+
+/*
+ * resize a used block in place, size is aligned already.
+ * return 0 if the block is resized.
+ *
+ * grow:   absorb the blank next block, if it is big enough
+ * shrink: split off the tail as a blank block
+ */
+static int heap_resize_block(blk_node_t *node, size_t size)
+{
+    blk_node_t *next = node->next, *tail;
+    size_t old_size = node->size;
+
+    if (size > node->size)
+    {
+        if (!next || (next->flag != 0) ||
+            (node->size + BLOCK_NODE_SZ + next->size < size))
+        {
+            return -1;
+        }
+
+        tlsf_remove(next);
+
+        heap_remain_add(node->cls, -(long)(next->size + BLOCK_NODE_SZ));
+
+        node->size += next->size + BLOCK_NODE_SZ;
+        node->next = next->next;
+        if (next->next)
+            next->next->prev = node;
+
+        next = node->next;
+    }
+
+    /*
+     * remain is too small to be a blank block
+     */
+    if (node->size - size < ALLOC_MIN_BYTES + BLOCK_NODE_SZ)
+    {
+        stats_account(node, (long)node->size - (long)old_size, 0);
+        return 0;
+    }
+
+    tail = (blk_node_t *)((size_t)node->block + size);
+    tail->flag  = 0;
+    tail->cls   = node->cls;
+    tail->block = (unsigned char *)tail + BLOCK_NODE_SZ;
+    tail->size  = node->size - size - BLOCK_NODE_SZ;
+    tail->prev  = node;
+    tail->next  = next;
+    if (next)
+        next->prev = tail;
+
+    node->size = size;
+    node->next = tail;
+
+    heap_remain_add(node->cls, tail->size + BLOCK_NODE_SZ);
+    stats_account(node, (long)size - (long)old_size, 0);
+
+    /*
+     * Combine next block node
+     */
+    if (next && (next->flag == 0))
+    {
+        tlsf_remove(next);
+
+        tail->size += next->size + BLOCK_NODE_SZ;
+        tail->next = next->next;
+        if (next->next)
+            next->next->prev = tail;
+    }
+
+    tlsf_insert(tail);
+
+    return 0;
+}
+
+static inline size_t heap_align_size(size_t size)
+{
+    return size <= ALLOC_MIN_BYTES ? ALLOC_MIN_BYTES : align_up(size, ALLOC_ALIGNMENT);
+}
+
+//-----------------------------------------------------------------------------
+// allocation trace
+//-----------------------------------------------------------------------------
+
+#if HEAP_TRACE
+
+static heap_trace_rec_t *trace_ring = NULL;
+static uint32_t          trace_mask = 0;
+static uint32_t          trace_head = 0;            /* records written */
+static volatile int      trace_on   = 0;
+
+static void heap_trace_record(int op, void *ptr, size_t size, unsigned int cls, void *caller)
+{
+    heap_trace_rec_t *rec;
+    uint32_t idx;
+
+    if (!trace_on)
+    {
+        return;
+    }
+
+    /*
+     * reserve a slot, isr or other task may write at the same time
+     */
+    idx = __atomic_fetch_add(&trace_head, 1, __ATOMIC_RELAXED);
+    rec = &trace_ring[idx & trace_mask];
+
+    rec->timestamp = stable_counter_read();
+    rec->ptr       = (uint64_t)(size_t)ptr;
+    rec->caller    = (uint64_t)(size_t)caller;
+    rec->size      = (uint32_t)size;
+    rec->task_id   = HEAP_TRACE_TASK_ID();
+    rec->op        = (uint8_t)op;
+    rec->cls       = (uint8_t)cls;
+}
+
+int heap_trace_start(unsigned int records)
+{
+    heap_trace_rec_t *ring;
+
+    if ((records < 2) || (records & (records - 1)))
+    {
+        return -1;
+    }
+
+    if (trace_ring && (trace_mask + 1 == records))
+    {
+        trace_on = 1;
+        return 0;
+    }
+
+    heap_trace_release();
+
+    /*
+     * the buffer itself is not traced
+     */
+    ring = (heap_trace_rec_t *)malloc(records * sizeof(heap_trace_rec_t));
+    if (!ring)
+    {
+        return -1;
+    }
+
+    trace_ring = ring;
+    trace_mask = records - 1;
+    trace_head = 0;
+    trace_on   = 1;
+
+    return 0;
+}
+
+void heap_trace_stop(void)
+{
+    trace_on = 0;
+}
+
+void heap_trace_release(void)
+{
+    heap_trace_rec_t *ring = trace_ring;
+
+    trace_on = 0;
+    trace_ring = NULL;
+    trace_mask = 0;
+    trace_head = 0;
+
+    if (ring)
+    {
+        free(ring);
+    }
+}
+
+/*
+ * stop the trace before dump, else the oldest records may be overwritten
+ */
+int heap_trace_dump(heap_trace_write_t write, void *arg)
+{
+    heap_trace_hdr_t hdr;
+    uint32_t head, count, first, i;
+
+    if (!write || !trace_ring)
+    {
+        return -1;
+    }
+
+    head  = trace_head;
+    count = head > trace_mask + 1 ? trace_mask + 1 : head;
+    first = head - count;
+
+    hdr.magic      = HEAP_TRACE_MAGIC;
+    hdr.version    = HEAP_TRACE_VERSION;
+    hdr.rec_size   = sizeof(heap_trace_rec_t);
+    hdr.count      = count;
+    hdr.lost       = first;
+    hdr.counter_hz = stable_counter_hz();
+
+    if (write(&hdr, sizeof(hdr), arg) != sizeof(hdr))
+    {
+        return -1;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (write(&trace_ring[(first + i) & trace_mask], sizeof(heap_trace_rec_t), arg) !=
+            sizeof(heap_trace_rec_t))
+        {
+            return -1;
+        }
+    }
+
+    return (int)count;
+}
+
+#else
+
+#define heap_trace_record(op, ptr, size, cls, caller)
+
+#endif // #if HEAP_TRACE
+
+//-----------------------------------------------------------------------------
+// malloc() function
+//-----------------------------------------------------------------------------
+
+/*
+ * try the class first, then the others in heap_class_order
+ */
+static void *heap_malloc(size_t size, unsigned int cls, void *caller)
+{
+    blk_node_t *node = NULL;
+    uint64_t begin = stable_counter_read();
+    int i;
+
+	if ((size <= 0) || (size > heap_total_bytes) || (cls >= HEAP_CLASS_MAX))
+    {
+        malloc_oslock();
+        heap_counter.fail_count++;
+        malloc_osunlock();
+        return NULL;
+    }
+
+    size = heap_align_size(size);
+
+    malloc_oslock();
+
+    for (i = 0; (i < HEAP_CLASS_MAX) && !node; i++)
+    {
+        node = heap_alloc_block(size, heap_class_order[cls][i]);
+    }
+
+    heap_counter.alloc_count++;
+    if (!node)
+    {
+        heap_counter.fail_count++;
+    }
+    else
+    {
+        heap_trace_record(HEAP_TRACE_MALLOC, node->block, node->size, node->cls, caller);
+    }
+
+    stats_record(heap_counter.alloc_hist, &heap_counter.alloc_max_cycles,
+                 stable_counter_read() - begin);
+
+	malloc_osunlock();
+
+	return node ? node->block : NULL;
+}
+
+void *malloc_class(size_t size, unsigned int cls)
+{
+    return heap_malloc(size, cls, __builtin_return_address(0));
+}
+
+void *malloc(size_t size)
+{
+    return heap_malloc(size, HEAP_CLASS_BULK, __builtin_return_address(0));
+}
+
+//-----------------------------------------------------------------------------
+// free() function
+//-----------------------------------------------------------------------------
+
+static void heap_free(void *ptr, void *caller)
+{
+    blk_node_t *found_node;
+    uint64_t begin = stable_counter_read();
+
+    if (!ptr)
+    {
+        return;
+    }
+
+    malloc_oslock();
+
+    /*
+     * node header is just before the block
+     */
+    found_node = block_to_node(ptr);
+
+    if (!found_node)
+    {
+        malloc_osunlock();
+        if (osal_is_osrunning())
+        {
+            printk("fatal error: free memory @0x%016lx\r\n", (long)ptr);
+        }
+        return;
+    }
+
+    heap_trace_record(HEAP_TRACE_FREE, ptr, found_node->size, found_node->cls, caller);
+
+    heap_free_block(found_node);
+
+    heap_counter.free_count++;
+    stats_record(heap_counter.free_hist, &heap_counter.free_max_cycles,
+                 stable_counter_read() - begin);
+
+    malloc_osunlock();
+}
+
+void free(void *ptr)
+{
+    heap_free(ptr, __builtin_return_address(0));
+}
+
+//-----------------------------------------------------------------------------
+// calloc() function
+//-----------------------------------------------------------------------------
+
+void *calloc(size_t nmemb, size_t size)
+{
+    void *ptr = heap_malloc(nmemb * size, HEAP_CLASS_BULK, __builtin_return_address(0));
+
+    if (ptr)
+    {
+        memset(ptr, 0x00, nmemb * size);
+    }
+
+    return ptr;
+}
+
+//-----------------------------------------------------------------------------
+// realloc() function
+//-----------------------------------------------------------------------------
+
+/*
+ * grow or shrink in place if possible, else move and copy min(old, new) bytes.
+ * if fail, the original block is untouched.
+ */
+void *realloc(void *ptr, size_t size)
+{
+    blk_node_t *node;
+    size_t old_size;
+    unsigned int cls;
+    void *newptr, *caller = __builtin_return_address(0);
+
+    if (size <= 0)
+    {
+        return NULL;
+    }
+
+    if (!ptr)
+    {
+        return heap_malloc(size, HEAP_CLASS_BULK, caller);
+    }
+
+    malloc_oslock();
+
+    node = block_to_node(ptr);
+
+    if (!node)
+    {
+        malloc_osunlock();
+        if (osal_is_osrunning())
+        {
+            printk("fatal error: realloc memory @0x%016lx\r\n", (long)ptr);
+        }
+        return NULL;
+    }
+
+    if ((size <= heap_total_bytes) &&
+        (heap_resize_block(node, heap_align_size(size)) == 0))
+    {
+        heap_trace_record(HEAP_TRACE_RESIZE, ptr, node->size, node->cls, caller);
+        malloc_osunlock();
+        return ptr;
+    }
+
+    old_size = node->size;
+    cls      = node->cls;
+
+    malloc_osunlock();
+
+    newptr = heap_malloc(size, cls, caller);
+
+    if (newptr)
+    {
+        memcpy(newptr, ptr, old_size < size ? old_size : size);
+        heap_free(ptr, caller);
+    }
+
+    return newptr;
+}
+
+#endif // OS Functions
+
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// realloc() function
+//-----------------------------------------------------------------------------
+
+#ifdef OS_RTTHREAD
+
+void *realloc(void *ptr, size_t size)
+{
+    return rt_realloc(ptr, size);
+}
+
+void *aligned_malloc(size_t size, unsigned int align)
+{
+    return rt_malloc_align((rt_size_t)size, (rt_size_t)align);
+}
+
+void aligned_free(void *addr)
+{
+    rt_free_align(addr);
+}
+
+#else
+
+#if defined(OS_FREERTOS)
+
+void *realloc(void *ptr, size_t size)
+{
+    if (size <= 0)
+    {
+        return NULL;
+    }
+
+    void *newptr = malloc(size);
+    
+    if (newptr)
+    {
+        if (ptr)
+        {
+            memcpy(newptr, ptr, size);
+            free(ptr);
+        }
+
+        return newptr;
+    }
+
+    if (ptr)
+    {
+        free(ptr);      // 如果没有申请到内存, 是否释放?
+    }
+
+    return NULL;
+}
+
+#endif // #if defined(OS_FREERTOS)
+
+//-----------------------------------------------------------------------------
+// aligned_malloc() function
+//-----------------------------------------------------------------------------
+
+#if defined(OS_FREERTOS)
+#define malloc_class(size, cls)     malloc(size)
+#endif
+
+void *aligned_malloc_class(size_t size, unsigned int align, unsigned int cls)
+{
+    void *head;
+    void **addr=NULL;
+#if !defined(OS_FREERTOS)
+    blk_node_t *node;
+#endif
+
+    if ((size <= 0) || (align == 0))
+    {
+        return NULL;
+    }
+
+    align = (align + 7) & ~0x7;     // atleast aligned 8
+
+    head = (void *)malloc_class(size + align - 1 + sizeof(void *), cls);
+
+    if (head == NULL)
+    {
+        return NULL;
+    }
+
+    /*
+     * align is not power of 2
+     */
+    if (align & (align - 1))
+    {
+        addr = (void **)((((size_t)head + sizeof(void *) + align - 1) / align) * align);
+    }
+    else
+    {
+        addr = (void **)align_up((size_t)head + sizeof(void *), (size_t)align);
+    }
+
+    addr[-1] = head;
+
+#if !defined(OS_FREERTOS)
+    /*
+     * give back the unused tail
+     */
+    malloc_oslock();
+    node = block_to_node(head);
+    if (heap_resize_block(node, heap_align_size((size_t)addr + size - (size_t)head)) == 0)
+    {
+        heap_trace_record(HEAP_TRACE_RESIZE, head, node->size, node->cls,
+                          __builtin_return_address(0));
+    }
+    malloc_osunlock();
+#endif
+
+    return addr;
+}
+
+void *aligned_malloc(size_t size, unsigned int align)
+{
+    return aligned_malloc_class(size, align, HEAP_CLASS_BULK);
+}
+
+//-----------------------------------------------------------------------------
+// aligned_free() function
+//-----------------------------------------------------------------------------
+
+void aligned_free(void *addr)
+{
+    if (addr)
+    {
+        void *ptr = ((void **)addr)[-1];
+        free(ptr);
+    }
+}
+
+#endif // #ifdef OS_RTTHREAD
+
+//-----------------------------------------------------------------------------
+// aligned_realloc() function
+//-----------------------------------------------------------------------------
+
+#if defined(OS_RTTHREAD) || defined(OS_FREERTOS)
+
+void *aligned_realloc(void *ptr, size_t size, unsigned int align)
+{
+    if (size <= 0)
+    {
+        return NULL;
+    }
+
+    void *newptr = aligned_malloc(size, align);
+
+    if (newptr)
+    {
+        if (ptr)
+        {
+            memcpy(newptr, ptr, size);
+
+            aligned_free(ptr);
+        }
+
+        return newptr;
+    }
+
+    if (ptr)
+    {
+        aligned_free(ptr);      // 如果没有申请到内存, 是否释放?
+    }
+
+    return NULL;
+}
+
+#else
+
+/*
+ * the block is resized in place when the alignment still hold, else move and
+ * copy min(old, new) bytes. if fail, the original block is untouched.
+ */
+void *aligned_realloc(void *ptr, size_t size, unsigned int align)
+{
+    blk_node_t *node;
+    size_t offset, old_size = 0, need;
+    unsigned int cls;
+    void *head, *newptr;
+
+    if ((size <= 0) || (align == 0))
+    {
+        return NULL;
+    }
+
+    if (!ptr)
+    {
+        return aligned_malloc(size, align);
+    }
+
+    align = (align + 7) & ~0x7;     // same as aligned_malloc()
+
+    head   = ((void **)ptr)[-1];
+    offset = (size_t)ptr - (size_t)head;
+
+    malloc_oslock();
+
+    node = block_to_node(head);
+
+    if (!node)
+    {
+        malloc_osunlock();
+        if (osal_is_osrunning())
+        {
+            printk("fatal error: aligned_realloc memory @0x%016lx\r\n", (long)ptr);
+        }
+        return NULL;
+    }
+
+    need = align_up(offset + size, ALLOC_ALIGNMENT);
+
+    if (((size_t)ptr % align == 0) && (need <= heap_total_bytes) &&
+        (heap_resize_block(node, need < ALLOC_MIN_BYTES ? ALLOC_MIN_BYTES : need) == 0))
+    {
+        heap_trace_record(HEAP_TRACE_RESIZE, head, node->size, node->cls,
+                          __builtin_return_address(0));
+        malloc_osunlock();
+        return ptr;
+    }
+
+    old_size = node->size - offset;
+    cls      = node->cls;
+
+    malloc_osunlock();
+
+    newptr = aligned_malloc_class(size, align, cls);
+
+    if (newptr)
+    {
+        memcpy(newptr, ptr, old_size < size ? old_size : size);
+        aligned_free(ptr);
+    }
+
+    return newptr;
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+
+#endif // #if !BSP_USE_FS
+
+/*
+ * @@ END
+ */
+
@@ -1,7 +1,7 @@
-﻿#ifndef RB_DRIVER_MPU6050_H
-#define RB_DRIVER_MPU6050_H
-
-void mpu6050_init(void);
-
-#endif // RB_DRIVER_MPU6050_H
-
+﻿#ifndef RB_DRIVER_MPU6050_H
+#define RB_DRIVER_MPU6050_H
+
+void mpu6050_init(void);
+
+#endif // RB_DRIVER_MPU6050_H
+
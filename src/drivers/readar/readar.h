@@ -1,7 +1,7 @@
-﻿#ifndef RB_DRIVER_READAR_H
-#define RB_DRIVER_READAR_H
-
-void readar_init(void);
-
-#endif // RB_DRIVER_READAR_H
-
+﻿#ifndef RB_DRIVER_READAR_H
+#define RB_DRIVER_READAR_H
+
+void readar_init(void);
+
+#endif // RB_DRIVER_READAR_H
+
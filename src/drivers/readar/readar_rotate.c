@@ -1,153 +1,191 @@
-/*
- * readar_rotate.c - 雷达旋转控制模块
- *
- * 功能说明:
- *   本模块负责控制雷达舵机进行 360 度旋转扫描
- *   同时接收来自 readar 模块的测距数据，并进行数据格式化
- *
- * 硬件连接:
- *   - PWM 输出: devPWM0 (用于控制舵机角度)
- *   - 队列输入: supersonic_to_redar (接收雷达数据)
- *   - 队列输出: redar_to_serial (发送到串口)
- *   - 队列输出: redar_to_algorithm (发送到算法)
- *
- * 数据流程:
- *   1. 从 supersonic_to_redar 队列接收 3 字节测距数据
- *   2. 根据当前角度控制 PWM 输出，驱动舵机转动
- *   3. 等待 50ms 使舵机稳定
- *   4. 存储数据到 ANGleforEVEDIS 缓冲区
- *   5. 将完整的一圈数据 (360 个角度) 发送到输出队列
- */
-
-#include "readar_rotate.h"
-#include "peripherals.h"
-#include "ls2k_pwm.h"
-#include "osal.h"
-#include <stdio.h>
-
-/*
- * ANGleforEVEDIS - 雷达角度距离数据缓冲区
- *
- * 大小: 360 x 3 = 1080 字节
- * 存储格式: [字节0][字节1][字节2] x 360 个角度
- * 用途: 保存一圈扫描的完整数据，发送到串口和算法模块
- */
-static uint8_t ANGleforEVEDIS[360*3] = {0};
-
-/*
- * using_READAR_FOR_ROTATE_step1_task - 雷达旋转扫描任务
- *
- * 功能:
- *   控制雷达舵机旋转，同时采集各角度的距离数据
- *
- * 执行流程:
- *   1. 获取三个消息队列的句柄
- *   2. 循环 360 次 (每度采集一次):
- *      a. 从输入队列接收 3 字节测距数据
- *      b. 配置 PWM 参数，使能对应角度
- *      c. 等待 50ms 让舵机稳定
- *      d. 将数据存入缓冲区
- *      e. 停止 PWM
- *   3. 将完整数据发送到串口队列
- *   4. 将完整数据发送到算法队列
- *
- * PWM 控制说明:
- *   - mode: PWM_CONTINUE_PULSE (连续脉冲模式)
- *   - hi_ns: 500 + 2000 * (theta/360) 纳秒 (高电平时间)
- *   - lo_ns: 19500 - 2000 * (theta/360) 纳秒 (低电平时间)
- *   - 这是一个简化的 PWM 控制，角度范围 0-360 度
- */
-static void using_READAR_FOR_ROTATE_step1_task(void *arg)
-{
-    /* 获取三个消息队列的句柄 */
-    osal_mq_t q_in = peripherals_get_supersonic_to_redar();      /* 输入队列 */
-    osal_mq_t q_serial = peripherals_get_redar_to_serial();       /* 输出到串口 */
-    osal_mq_t q_algo = peripherals_get_redar_to_algorithm();      /* 输出到算法 */
-    if (!q_in || !q_serial || !q_algo) return;
-
-    /*
-     * ANGLE 数组: 用于算法处理的 32 位整数格式
-     * 每个角度对应一个 32 位整数 (4 字节)
-     * 大小: 360 x 4 = 1440 字节
-     */
-    int ANGLE[360] = {0};
-
-    /* 循环扫描 360 度 */
-    for (int t = 0; t < 360; t++)
-    {
-        /* 接收 3 字节测距数据 */
-        uint8_t DAta1[3] = {0};
-        if (osal_mq_receive(q_in, DAta1, sizeof(DAta1), OSAL_WAIT_FOREVER) == 0)
-        {
-            /* 计算当前角度的 PWM 参数 */
-            float theta = (float)t;
-            pwm_cfg_t pwm_cfg1;
-
-            /* 配置 PWM: 连续脉冲模式 */
-            pwm_cfg1.mode = PWM_CONTINUE_PULSE;
-
-            /*
-             * PWM 占空比计算:
-             * 周期 = 20ms (20000ns)
-             * 高电平范围: 500ns ~ 2500ns (对应 0.5ms ~ 2.5ms)
-             * 低电平范围: 19500ns ~ 17500ns
-             */
-            pwm_cfg1.hi_ns = 500 + 2000 * (theta/360.0f);   /* 高电平时间 */
-            pwm_cfg1.lo_ns = 19500 - 2000 * (theta/360.0f);  /* 低电平时间 */
-
-            /* 启动 PWM，控制舵机转到指定角度 */
-            ls2k_pwm_pulse_start(devPWM0, &pwm_cfg1);
-
-            /* 等待舵机稳定 */
-            delay_ms(50);
-
-            /*
-             * 存储数据到缓冲区 (两种格式)
-             */
-            /* 格式 1: 原始 3 字节 (用于串口输出) */
-            ANGleforEVEDIS[3*t]   = DAta1[0];
-            ANGleforEVEDIS[3*t+1] = DAta1[1];
-            ANGleforEVEDIS[3*t+2] = DAta1[2];
-
-            /* 格式 2: 32 位整数 (用于算法处理) */
-            /* 高字节在前: DATA[0] << 16 | DATA[1] << 8 | DATA[2] */
-            ANGLE[t] = (DAta1[0] << 16) | (DAta1[1] << 8) | DAta1[2];
-
-            /* 停止 PWM */
-            ls2k_pwm_pulse_stop(devPWM0);
-        }
-    }
-
-    /*
-     * 一圈扫描完成，发送数据到两个输出队列
-     */
-    /* 发送 1080 字节到串口队列 */
-    if (osal_mq_send(q_serial, ANGleforEVEDIS, sizeof(ANGleforEVEDIS)) != 0)
-    {
-        printk("Failed to send angle distance data to serial\n");
-    }
-
-    /* 发送 1440 字节到算法队列 */
-    if (osal_mq_send(q_algo, ANGLE, sizeof(ANGLE)) != 0)
-    {
-        printk("Failed to send angle distance data to algorithm\n");
-    }
-}
-
-/*
- * readar_rotate_init - 雷达旋转控制初始化
- *
- * 功能:
- *   创建雷达旋转扫描任务
- *
- * 任务参数:
- *   - 任务名: "rotationFradar"
- *   - 栈大小: 4096 字节
- *   - 优先级: 0 (最高)
- *   - 入口函数: using_READAR_FOR_ROTATE_step1_task
- */
-void readar_rotate_init(void)
-{
-    osal_task_create("rotationFradar", 4096, 0, 0, using_READAR_FOR_ROTATE_step1_task, NULL);
-}
-
+/*
+ * readar_rotate.c - 雷达旋转控制模块
+ *
+ * 功能说明:
+ *   本模块负责控制雷达舵机进行 360 度旋转扫描
+ *   同时接收来自 readar 模块的测距数据，并进行数据格式化
+ *
+ * 硬件连接:
+ *   - PWM 输出: devPWM0 (用于控制舵机角度)
+ *   - 邮箱输入: supersonic_to_redar (接收最新的雷达数据)
+ *   - 主题输出: radar/scan (串口和算法订阅)
+ *
+ * 数据流程:
+ *   1. 从 supersonic_to_redar 邮箱接收最新的 3 字节测距数据
+ *   2. 存储数据到从 radar/scan 主题借用 (loan) 的缓冲区中
+ *   3. 根据当前角度控制 PWM 输出，驱动舵机转动
+ *   4. 下一个 50ms 周期停止 PWM, 舵机已经稳定, 处理下一个角度
+ *
+ *   步进由 HPET 的周期 hrtimer 定时, 不随 ms clock tick 抖动; 没有 HPET0
+ *   时用周期任务.
+ *   5. 完整的一圈数据 (360 个角度) 发布到主题, 订阅者共享, 不再复制
+ */
+
+#include "readar_rotate.h"
+#include "peripherals.h"
+#include "ls2k_pwm.h"
+#include "bsp.h"
+#include "osal.h"
+#include "pesudo_topic.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ROTATE_PERIOD_US    50000   /* 每个角度 50ms, 等待舵机稳定 */
+
+/*
+ * 扫描状态, 在周期之间保持
+ */
+static int  m_angle  = 0;           /* 当前角度 0~359 */
+static int  m_pwm_on = 0;           /* 当前角度的 PWM 已启动 */
+
+static topic_t *m_scan_topic = NULL;
+
+#if BSP_USE_HPET0
+static osal_hrtimer_t m_step_timer = NULL;
+#endif
+
+/*
+ * ANGleforEVEDIS - 雷达角度距离数据, radar/scan 主题中借用的缓冲区
+ *
+ * 大小: 360 x 3 = 1080 字节
+ * 存储格式: [字节0][字节1][字节2] x 360 个角度, 高字节在前
+ */
+static uint8_t *ANGleforEVEDIS = NULL;
+
+/*
+ * using_READAR_FOR_ROTATE_step1_task - 雷达旋转扫描任务
+ *
+ * 功能:
+ *   控制雷达舵机旋转，同时采集各角度的距离数据
+ *   周期 hrtimer (或周期任务), 每 50ms 处理一个角度. 以前在任务中
+ *   delay_ms(50) 等待舵机, 一圈 360 次, CPU 一直空转. 在主循环中执行,
+ *   不能阻塞
+ *
+ * 执行流程 (每个周期):
+ *   1. 上个周期启动了 PWM: 舵机已稳定 50ms, 停止 PWM, 转到下一个角度
+ *   2. 一圈 360 个角度完成: 发布借用的缓冲区到 radar/scan 主题
+ *   3. 一圈开始时从主题借用缓冲区, 没有空闲的缓冲区时下个周期再试
+ *   4. 从输入邮箱接收最新的测距数据, 没有新数据时下个周期再试
+ *   5. 将数据直接写入借用的缓冲区
+ *   6. 配置 PWM 参数，使能对应角度
+ *
+ * PWM 控制说明:
+ *   - mode: PWM_CONTINUE_PULSE (连续脉冲模式)
+ *   - hi_ns: 500 + 2000 * (theta/360) 纳秒 (高电平时间)
+ *   - lo_ns: 19500 - 2000 * (theta/360) 纳秒 (低电平时间)
+ *   - 这是一个简化的 PWM 控制，角度范围 0-360 度
+ */
+static void using_READAR_FOR_ROTATE_step1_task(void *arg)
+{
+    /* 获取输入邮箱和输出主题 */
+    osal_mq_t q_in = peripherals_get_supersonic_to_redar();      /* 输入邮箱 */
+    topic_t *scan = m_scan_topic;                                 /* 输出主题 */
+    if (!q_in || !scan) return;
+
+    /* 上个周期的角度已稳定 */
+    if (m_pwm_on)
+    {
+        /* 停止 PWM */
+        ls2k_pwm_pulse_stop(devPWM0);
+        m_pwm_on = 0;
+        m_angle++;
+    }
+
+    /*
+     * 一圈扫描完成，发布到主题, 每个订阅者得到同一块缓冲区
+     */
+    if (m_angle >= RADAR_SCAN_ANGLES)
+    {
+        if (topic_publish(scan, ANGleforEVEDIS) < 0)
+        {
+            printk("Failed to publish angle distance data\n");
+        }
+
+        ANGleforEVEDIS = NULL;
+        m_angle = 0;
+        return;
+    }
+
+    /*
+     * 一圈开始, 从主题借用缓冲区, 扫描数据直接写在缓冲区中
+     * 订阅者还没有释放时没有空闲的缓冲区, 下个周期再试
+     */
+    if (!ANGleforEVEDIS)
+    {
+        ANGleforEVEDIS = (uint8_t *)topic_loan(scan);
+        if (!ANGleforEVEDIS) return;
+
+        memset(ANGleforEVEDIS, 0, RADAR_SCAN_BYTES);
+    }
+
+    /* 接收最新的 3 字节测距数据, 周期任务不能阻塞 */
+    uint8_t DAta1[3] = {0};
+    if (osal_mq_receive(q_in, DAta1, sizeof(DAta1), 0) != 0)
+    {
+        return;
+    }
+
+    int t = m_angle;
+
+    /*
+     * 存储原始 3 字节到缓冲区, 串口直接发送, 算法自己转换为整数
+     */
+    ANGleforEVEDIS[3*t]   = DAta1[0];
+    ANGleforEVEDIS[3*t+1] = DAta1[1];
+    ANGleforEVEDIS[3*t+2] = DAta1[2];
+
+    /* 计算当前角度的 PWM 参数 */
+    float theta = (float)t;
+    pwm_cfg_t pwm_cfg1;
+
+    /* 配置 PWM: 连续脉冲模式 */
+    pwm_cfg1.mode = PWM_CONTINUE_PULSE;
+
+    /*
+     * PWM 占空比计算:
+     * 周期 = 20ms (20000ns)
+     * 高电平范围: 500ns ~ 2500ns (对应 0.5ms ~ 2.5ms)
+     * 低电平范围: 19500ns ~ 17500ns
+     */
+    pwm_cfg1.hi_ns = 500 + 2000 * (theta/360.0f);   /* 高电平时间 */
+    pwm_cfg1.lo_ns = 19500 - 2000 * (theta/360.0f);  /* 低电平时间 */
+
+    /* 启动 PWM，控制舵机转到指定角度, 下个周期停止 */
+    ls2k_pwm_pulse_start(devPWM0, &pwm_cfg1);
+    m_pwm_on = 1;
+}
+
+/*
+ * readar_rotate_init - 雷达旋转控制初始化
+ *
+ * 功能:
+ *   查找 radar/scan 主题, 创建并启动舵机步进的周期 hrtimer
+ *
+ * 定时器参数:
+ *   - 名称: "rotationFradar"
+ *   - 周期: 50ms, shell 命令 "hrtimer" 查看回调延迟
+ *   - 回调函数: using_READAR_FOR_ROTATE_step1_task
+ *
+ *   没有 HPET0 时创建同名的周期任务, 截止时间等于周期
+ */
+void readar_rotate_init(void)
+{
+    m_scan_topic = topic_find(RADAR_TOPIC_SCAN);
+
+#if BSP_USE_HPET0
+    m_step_timer = osal_hrtimer_create("rotationFradar", using_READAR_FOR_ROTATE_step1_task,
+                                       NULL, ROTATE_PERIOD_US, true);
+    if (m_step_timer && (osal_hrtimer_start(m_step_timer, 0) == OSAL_ERR_OK))
+    {
+        return;
+    }
+
+    osal_hrtimer_delete(m_step_timer);
+    m_step_timer = NULL;
+    printk("rotate: hrtimer fail, use periodic task\n");
+#endif
+
+    osal_task_create_periodic("rotationFradar", ROTATE_PERIOD_US, ROTATE_PERIOD_US,
+                              using_READAR_FOR_ROTATE_step1_task);
+}
+
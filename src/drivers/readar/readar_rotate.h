@@ -1,7 +1,7 @@
-﻿#ifndef RB_DRIVER_READAR_ROTATE_H
-#define RB_DRIVER_READAR_ROTATE_H
-
-void readar_rotate_init(void);
-
-#endif // RB_DRIVER_READAR_ROTATE_H
-
+﻿#ifndef RB_DRIVER_READAR_ROTATE_H
+#define RB_DRIVER_READAR_ROTATE_H
+
+void readar_rotate_init(void);
+
+#endif // RB_DRIVER_READAR_ROTATE_H
+
@@ -1,167 +1,260 @@
-﻿/*
- * uart_dma.c - 串口 DMA 通信模块
- *
- * 功能说明:
- *   本模块负责通过 DMA 方式将雷达扫描数据发送到上位机
- *   使用 DMA 可以大大减轻 CPU 负担，提高数据传输效率
- *
- * 硬件连接:
- *   - UART 接口: BSP_USE_UART2
- *   - 波特率: 115200
- *   - DMA 通道 4: 发送 (UART2 TX)
- *   - DMA 通道 5: 接收 (UART2 RX)
- *
- * 数据流程:
- *   1. 从 redar_to_serial 队列接收雷达数据 (1080 字节)
- *   2. 初始化 UART2 为 DMA 模式
- *   3. 初始化 DMA 控制器
- *   4. 配置 DMA 发送通道 (通道 4)
- *   5. 启动 DMA 传输，将数据发送到串口
- *   6. 同时配置 DMA 接收通道 (通道 5)，准备接收上位机命令
- */
-
-#include "uart_dma.h"
-#include "peripherals.h"
-#include "ls2k_uart.h"
-#include "ls2k_dma.h"
-#include "osal.h"
-#include <stdio.h>
-
-/*
- * ANGleforEVEDIS - 接收缓冲区
- *
- * 大小: 1080 字节 (360 x 3)
- * 用途: 存储从上位机通过 UART 接收的命令数据
- */
-static uint8_t ANGleforEVEDIS[3*360] = {0};
-
-/*
- * using_uart_digit_task - 串口 DMA 发送任务
- *
- * 功能:
- *   接收雷达数据并通过 DMA 发送到串口
- *
- * 执行流程:
- *   1. 获取消息队列句柄 (redar_to_serial)
- *   2. 等待并接收 1080 字节的雷达数据
- *   3. 初始化 UART2:
- *      - 设置波特率 115200
- *      - 打开 UART
- *      - 配置为 DMA 模式
- *   4. 初始化 DMA 控制器
- *   5. 打开 DMA 通道 0 和 1
- *   6. 检查通道 4 是否空闲:
- *      - 如果空闲，配置发送参数
- *      - 打开通道 4 并启动 DMA 传输
- *   7. 检查通道 5 是否空闲:
- *      - 如果空闲，配置接收参数
- *      - 打开通道 5 准备接收
- *
- * DMA 配置说明:
- *   - 发送通道 (通道 4):
- *     .cb = NULL: 无回调函数
- *     .ccr32 = 0x00001093: 控制寄存器 (启用中断)
- *     .chNum = DMA_Channel_4: 通道号
- *     .device = UART2_BASE: UART2 基地址
- *     .devNum = DMA_UART2: DMA 设备号
- *     .memAddr = angeledistan: 源地址 (雷达数据)
- *     .transbytes = 1080: 传输字节数
- *
- *   - 接收通道 (通道 5):
- *     .cb = NULL: 无回调函数
- *     .ccr32 = 0x00001083: 控制寄存器
- *     .chNum = DMA_Channel_5: 通道号
- *     .device = UART2_BASE: UART2 基地址
- *     .devNum = DMA_UART2: DMA 设备号
- *     .memAddr = ANGleforEVEDIS: 目的地址 (接收缓冲区)
- *     .transbytes = 1080: 传输字节数
- */
-static void using_uart_digit_task(void *arg)
-{
-    /* 获取消息队列句柄，用于接收雷达数据 */
-    osal_mq_t q = peripherals_get_redar_to_serial();
-    if (!q) return;
-
-    /* 雷达数据缓冲区: 1080 字节 (360 个角度 x 3 字节) */
-    uint8_t angeledistan[3*360] = {0};
-
-    /* 从队列接收数据，超时等待 */
-    if (osal_mq_receive(q, angeledistan, sizeof(angeledistan), OSAL_WAIT_FOREVER) != 0) return;
-
-    /*
-     * UART2 初始化
-     */
-    UART_initialize(BSP_USE_UART2, 115200);          /* 初始化 UART2，波特率 115200 */
-    ls2k_uart_open(BSP_USE_UART2, NULL);             /* 打开 UART2 */
-    ls2k_uart_ioctl(BSP_USE_UART2, UART_WORK_DMA, NULL);  /* 配置为 DMA 模式 */
-
-    /*
-     * DMA 控制器初始化
-     */
-    ls2k_dma_init(NULL, NULL);                       /* 初始化 DMA 控制器 */
-
-    /* 打开 DMA 通道 0 和 1 (预留) */
-    ls2k_dma_open(DMA_Channel_1, NULL);
-    ls2k_dma_open(DMA_Channel_0, NULL);
-
-    /*
-     * 发送通道配置 (DMA 通道 4)
-     * 检查通道是否空闲，如果空闲则配置并启动传输
-     */
-    if (dma_get_idle_channel(DMA_UART2, 4) == 0)
-    {
-        /* DMA 发送配置结构体 */
-        struct dma_chnl_cfg messageSendingAngle = {
-            .cb        = NULL,                    /* 无回调函数 */
-            .ccr32     = 0x00001093,             /* 控制寄存器: 启用中断 */
-            .chNum     = DMA_Channel_4,          /* 通道号: 4 */
-            .device    = UART2_BASE,              /* 外设基地址: UART2 */
-            .devNum    = DMA_UART2,               /* DMA 设备号: UART2 */
-            .memAddr   = (uint32_t)angeledistan, /* 源地址: 雷达数据缓冲区 */
-            .transbytes = 360*3                   /* 传输字节数: 1080 */
-        };
-
-        /* 打开 DMA 通道 4 并启动传输 */
-        ls2k_dma_open(DMA_Channel_4, &messageSendingAngle);
-        dma_start(DMA_Channel_4, DMA_PRIORITY_MID);  /* 中等优先级启动 */
-    }
-
-    /*
-     * 接收通道配置 (DMA 通道 5)
-     * 检查通道是否空闲，如果空闲则配置接收通道
-     */
-    if (dma_get_idle_channel(DMA_UART2, 5) == 0)
-    {
-        /* DMA 接收配置结构体 */
-        struct dma_chnl_cfg messageRECiveingmessages = {
-            .cb        = NULL,                        /* 无回调函数 */
-            .ccr32     = 0x00001083,                 /* 控制寄存器 */
-            .chNum     = DMA_Channel_5,              /* 通道号: 5 */
-            .device    = UART2_BASE,                  /* 外设基地址: UART2 */
-            .devNum    = DMA_UART2,                   /* DMA 设备号: UART2 */
-            .memAddr   = (uint32_t)ANGleforEVEDIS,   /* 目的地址: 接收缓冲区 */
-            .transbytes = 360*3                       /* 传输字节数: 1080 */
-        };
-
-        /* 打开 DMA 通道 5，准备接收 */
-        ls2k_dma_open(DMA_Channel_5, &messageRECiveingmessages);
-    }
-}
-
-/*
- * uart_dma_init - 串口 DMA 模块初始化
- *
- * 功能:
- *   创建串口 DMA 发送任务
- *
- * 任务参数:
- *   - 任务名: "uart_digit_task"
- *   - 栈大小: 4096 字节
- *   - 优先级: 0 (最高)
- *   - 入口函数: using_uart_digit_task
- */
-void uart_dma_init(void)
-{
-    osal_task_create("uart_digit_task", 4096, 0, 0, using_uart_digit_task, NULL);
-}
-
+﻿/*
+ * uart_dma.c - 串口 DMA 通信模块
+ *
+ * 功能说明:
+ *   本模块负责通过 DMA 方式将雷达扫描数据发送到上位机
+ *   使用 DMA 可以大大减轻 CPU 负担，提高数据传输效率
+ *
+ * 硬件连接:
+ *   - UART 接口: BSP_USE_UART2
+ *   - 波特率: 115200
+ *   - DMA 通道 4: 发送 (UART2 TX)
+ *   - DMA 通道 5: 接收 (UART2 RX)
+ *
+ * 数据流程:
+ *   1. 订阅 radar/scan 主题, 收到雷达数据 (1080 字节) 的引用, 不复制
+ *   2. 初始化 UART2 为 DMA 模式
+ *   3. 初始化 DMA 控制器
+ *   4. 配置 DMA 发送通道 (通道 4)
+ *   5. 启动 DMA 传输，将数据发送到串口
+ *   6. 同时配置 DMA 接收通道 (通道 5)，准备接收上位机命令
+ */
+
+#include "uart_dma.h"
+#include "peripherals.h"
+#include "ls2k_uart.h"
+#include "ls2k_dma.h"
+#include "osal.h"
+#include "dma_buf.h"
+#include "pesudo_pt.h"
+#include <stdio.h>
+
+#define UART_DMA_BYTES  RADAR_SCAN_BYTES
+
+/*
+ * ANGleforEVEDIS - 接收缓冲区
+ *
+ * 大小: 1080 字节 (360 x 3)
+ * 用途: 存储从上位机通过 UART 接收的命令数据
+ *       uncache 地址, CPU 直接读到 DMA 写入的数据
+ */
+static uint8_t *ANGleforEVEDIS = NULL;
+
+/*
+ * 串口任务是无栈任务 (pesudo_pt.h), await 之间的状态放在这里
+ */
+typedef struct uart_digit
+{
+    pesudo_pt_t  pt;                        /* 必须是第一个成员 */
+    topic_sub_t *sub;                       /* radar/scan 的订阅 */
+    const void  *msg;                       /* 正在发送的消息, 主题的缓冲区 */
+    int          rt;
+    uint32_t     dropped;                   /* 通道 4 忙, 没有发送的扫描 */
+} uart_digit_t;
+
+static uart_digit_t m_uart_digit;
+
+/*
+ * uart_digit_dma_start - 发送队列中的消息, 并准备接收
+ *
+ * msg 是 radar/scan 主题的缓冲区 (cache 地址), 发送完成前不能释放
+ * 返回 0: 已启动发送, -1: 通道 4 不空闲或 msg 超过 4G, 没有发送
+ */
+static int uart_digit_dma_start(const void *msg)
+{
+    int rt = -1;
+
+    /* APB DMA 只有 32 位地址 */
+    if (!dma_buf_is32(msg, UART_DMA_BYTES))
+    {
+        return -1;
+    }
+
+    /* 写回 cache, DMA 从内存读到的是最新数据 */
+    dma_cache_flush(msg, UART_DMA_BYTES);
+
+    /*
+     * UART2 初始化
+     */
+    UART_initialize(BSP_USE_UART2, 115200);          /* 初始化 UART2，波特率 115200 */
+    ls2k_uart_open(BSP_USE_UART2, NULL);             /* 打开 UART2 */
+    ls2k_uart_ioctl(BSP_USE_UART2, UART_WORK_DMA, NULL);  /* 配置为 DMA 模式 */
+
+    /*
+     * DMA 控制器初始化
+     */
+    ls2k_dma_init(NULL, NULL);                       /* 初始化 DMA 控制器 */
+
+    /* 打开 DMA 通道 0 和 1 (预留) */
+    ls2k_dma_open(DMA_Channel_1, NULL);
+    ls2k_dma_open(DMA_Channel_0, NULL);
+
+    /*
+     * 发送通道配置 (DMA 通道 4)
+     * 检查通道是否空闲，如果空闲则配置并启动传输
+     */
+    if (dma_get_idle_channel(DMA_UART2, 4) == 0)
+    {
+        /* DMA 发送配置结构体 */
+        struct dma_chnl_cfg messageSendingAngle = {
+            .cb        = NULL,                    /* 无回调函数 */
+            .ccr32     = 0x00001093,             /* 控制寄存器: 启用中断 */
+            .chNum     = DMA_Channel_4,          /* 通道号: 4 */
+            .device    = UART2_BASE,              /* 外设基地址: UART2 */
+            .devNum    = DMA_UART2,               /* DMA 设备号: UART2 */
+            .memAddr   = dma_buf_phys32(msg),     /* 源地址: 主题中的雷达数据 */
+            .transbytes = UART_DMA_BYTES          /* 传输字节数: 1080 */
+        };
+
+        /* 打开 DMA 通道 4 并启动传输 */
+        ls2k_dma_open(DMA_Channel_4, &messageSendingAngle);
+        dma_start(DMA_Channel_4, DMA_PRIORITY_MID);  /* 中等优先级启动 */
+        rt = 0;
+    }
+
+    /*
+     * 接收通道配置 (DMA 通道 5)
+     * 检查通道是否空闲，如果空闲则配置接收通道
+     */
+    if (dma_get_idle_channel(DMA_UART2, 5) == 0)
+    {
+        /* DMA 接收配置结构体 */
+        struct dma_chnl_cfg messageRECiveingmessages = {
+            .cb        = NULL,                        /* 无回调函数 */
+            .ccr32     = 0x00001083,                 /* 控制寄存器 */
+            .chNum     = DMA_Channel_5,              /* 通道号: 5 */
+            .device    = UART2_BASE,                  /* 外设基地址: UART2 */
+            .devNum    = DMA_UART2,                   /* DMA 设备号: UART2 */
+            .memAddr   = dma_buf_phys32(ANGleforEVEDIS), /* 目的地址: 接收缓冲区 */
+            .transbytes = UART_DMA_BYTES              /* 传输字节数: 1080 */
+        };
+
+        /* 打开 DMA 通道 5，准备接收 */
+        ls2k_dma_open(DMA_Channel_5, &messageRECiveingmessages);
+    }
+
+    return rt;
+}
+
+/*
+ * using_uart_digit_task - 串口 DMA 发送任务 (无栈任务)
+ *
+ * 功能:
+ *   接收雷达数据并通过 DMA 发送到串口
+ *
+ * 执行流程:
+ *   1. await_topic() 等待 radar/scan 的订阅, 得到 1080 字节消息的引用
+ *   2. 等待发送通道 4 空闲, 每 1ms 查询一次, 然后直接从主题的缓冲区
+ *      启动 DMA, 不复制. 通道仍然忙时不发送, 计入 dropped
+ *   3. 初始化 UART2:
+ *      - 设置波特率 115200
+ *      - 打开 UART
+ *      - 配置为 DMA 模式
+ *   4. 初始化 DMA 控制器
+ *   5. 打开 DMA 通道 0 和 1
+ *   6. 检查通道 4 是否空闲:
+ *      - 如果空闲，配置发送参数
+ *      - 打开通道 4 并启动 DMA 传输
+ *   7. 检查通道 5 是否空闲:
+ *      - 如果空闲，配置接收参数
+ *      - 打开通道 5 准备接收
+ *   8. 等待发送通道空闲, 每 1ms 查询一次, 然后释放引用, 回到 1
+ *
+ *   任务在主循环的栈上运行, 等待时返回, 下次从等待处继续.
+ *   局部变量在 await 之间不保留, 状态在 m_uart_digit 中.
+ *
+ * DMA 配置说明:
+ *   - 发送通道 (通道 4):
+ *     .cb = NULL: 无回调函数
+ *     .ccr32 = 0x00001093: 控制寄存器 (启用中断)
+ *     .chNum = DMA_Channel_4: 通道号
+ *     .device = UART2_BASE: UART2 基地址
+ *     .devNum = DMA_UART2: DMA 设备号
+ *     .memAddr = 主题缓冲区的物理地址: 源地址 (雷达数据)
+ *     .transbytes = 1080: 传输字节数
+ *
+ *   - 接收通道 (通道 5):
+ *     .cb = NULL: 无回调函数
+ *     .ccr32 = 0x00001083: 控制寄存器
+ *     .chNum = DMA_Channel_5: 通道号
+ *     .device = UART2_BASE: UART2 基地址
+ *     .devNum = DMA_UART2: DMA 设备号
+ *     .memAddr = ANGleforEVEDIS 的物理地址: 目的地址 (接收缓冲区)
+ *     .transbytes = 1080: 传输字节数
+ */
+static void using_uart_digit_task(void *arg)
+{
+    uart_digit_t *u = (uart_digit_t *)arg;
+
+    pt_begin(&u->pt);
+
+    /* 接收缓冲区只分配一次 */
+    ANGleforEVEDIS = (uint8_t *)dma_buf_alloc_uncached(UART_DMA_BYTES);
+    if (!ANGleforEVEDIS)
+    {
+        printk("uart_digit_task: no dma buffer\n");
+        pt_exit(&u->pt);
+    }
+
+    for (;;)
+    {
+        /* 等待雷达数据, 没有数据时任务不运行 */
+        await_topic(&u->pt, u->sub, &u->msg, OSAL_WAIT_FOREVER, u->rt);
+        if (u->rt != OSAL_ERR_OK)
+        {
+            continue;
+        }
+
+        /* 上一次的发送没有完成, 等待而不是丢掉这一圈 */
+        while (dma_get_idle_channel(DMA_UART2, 4) != 0)
+        {
+            await_sleep(&u->pt, 1);
+        }
+
+        if (uart_digit_dma_start(u->msg) != 0)
+        {
+            u->dropped++;
+            topic_release(u->msg);
+            continue;
+        }
+
+        /* 发送完成前保持引用, 雷达不会借到这块缓冲区 */
+        while (dma_get_idle_channel(DMA_UART2, 4) != 0)
+        {
+            await_sleep(&u->pt, 1);
+        }
+
+        topic_release(u->msg);
+    }
+
+    pt_end(&u->pt);
+}
+
+/*
+ * uart_dma_init - 串口 DMA 模块初始化
+ *
+ * 功能:
+ *   订阅 radar/scan 主题, 创建串口 DMA 发送任务
+ *   队列深度 2, 串口来不及发送时丢弃最旧的一圈
+ *
+ * 任务参数:
+ *   - 任务名: "uart_digit_task"
+ *   - 无栈任务, 没有任务栈
+ *   - 优先级: TASK_PRIO_UART
+ *   - 入口函数: using_uart_digit_task
+ */
+void uart_dma_init(void)
+{
+    m_uart_digit.sub = topic_subscribe(topic_find(RADAR_TOPIC_SCAN), 2,
+                                       TOPIC_POLICY_DROP_OLDEST);
+    if (!m_uart_digit.sub) return;
+
+    osal_task_create_stackless("uart_digit_task", TASK_PRIO_UART,
+                               using_uart_digit_task, &m_uart_digit);
+}
+
+uint32_t uart_dma_dropped(void)
+{
+    return m_uart_digit.dropped;
+}
+
@@ -1,7 +1,14 @@
-﻿#ifndef RB_DRIVER_UART_DMA_H
-#define RB_DRIVER_UART_DMA_H
-
-void uart_dma_init(void);
-
-#endif // RB_DRIVER_UART_DMA_H
-
+﻿#ifndef RB_DRIVER_UART_DMA_H
+#define RB_DRIVER_UART_DMA_H
+
+#include <stdint.h>
+
+void uart_dma_init(void);
+
+/*
+ * 发送通道忙, 没有发送的雷达扫描数
+ */
+uint32_t uart_dma_dropped(void);
+
+#endif // RB_DRIVER_UART_DMA_H
+
@@ -0,0 +1,145 @@
+/*
+ * dma_buf.c - DMA 缓冲区
+ *
+ * 功能说明:
+ *   分配 cache line 对齐的 DMA 缓冲区, 提供 cache 写回/作废函数, 以及
+ *   cache/uncache 地址窗口和物理地址的转换.
+ *
+ *   优先从 HEAP_CLASS_DMA 的堆区域分配, 没有时退回普通堆.
+ *
+ * 注意:
+ *   cache 操作以整个 cache line 为单位, 对非本模块分配的缓冲区操作时,
+ *   首尾所在 cache line 中的其它数据也会被写回或作废.
+ *
+ *   cacop 的 D-cache hit 操作只有写回并作废一种 ([4:3] = 1 是 index 操作,
+ *   3 由实现定义), dma_cache_invalidate() 和 dma_cache_flush() 相同, 脏的
+ *   cache line 先写回. 只要 DMA 写入期间 CPU 不写缓冲区, 就没有脏行.
+ */
+
+#include "bsp.h"
+#include "dma_buf.h"
+#include "memory_man.h"
+
+#ifndef align_up
+#define align_up(num, align)    (((num) + ((align)-1)) & ~((align)-1))
+#endif
+
+/*
+ * cacop code: [4:3] = 2, hit writeback & invalidate; [2:0] = cache 编号
+ */
+#define CACOP_HIT_WBINV_L1D     0x11
+#define CACOP_HIT_WBINV_L2      0x12
+
+//-----------------------------------------------------------------------------
+
+#if __loongarch64
+
+static void dma_cache_wbinv(const void *addr, size_t size)
+{
+    size_t line = (size_t)addr & ~(size_t)(DMA_CACHE_LINE - 1);
+    size_t end  = (size_t)addr + size;
+
+    /*
+     * uncache 地址不在 cache 中
+     */
+    if (((uint64_t)line & ~DMA_ADDR_PHYS_MASK) != DMA_ADDR_CACHED)
+    {
+        return;
+    }
+
+    __asm__ __volatile__("dbar 0" ::: "memory");
+
+    for ( ; line < end; line += DMA_CACHE_LINE)
+    {
+        __asm__ __volatile__("cacop %0, %1, 0" :: "i"(CACOP_HIT_WBINV_L1D), "r"(line) : "memory");
+        __asm__ __volatile__("cacop %0, %1, 0" :: "i"(CACOP_HIT_WBINV_L2),  "r"(line) : "memory");
+    }
+
+    __asm__ __volatile__("dbar 0" ::: "memory");
+}
+
+#else
+
+static void dma_cache_wbinv(const void *addr, size_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+#endif
+
+void dma_cache_flush(const void *addr, size_t size)
+{
+    if (addr && size)
+    {
+        dma_cache_wbinv(addr, size);
+    }
+}
+
+void dma_cache_invalidate(const void *addr, size_t size)
+{
+    if (addr && size)
+    {
+        dma_cache_wbinv(addr, size);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void *dma_buf_alloc(size_t size)
+{
+    void *buf;
+
+    if (size == 0)
+    {
+        return NULL;
+    }
+
+    /*
+     * 长度取整, 缓冲区独占它的 cache line
+     */
+    size = align_up(size, DMA_CACHE_LINE);
+
+#if !BSP_USE_FS
+    buf = aligned_malloc_class(size, DMA_CACHE_LINE, HEAP_CLASS_DMA);
+#else
+    buf = aligned_malloc(size, DMA_CACHE_LINE);
+#endif
+
+    /*
+     * 超过 4G 的缓冲区 32 位地址的 DMA 控制器访问不到, 分配失败
+     */
+    if (buf && !dma_buf_is32(buf, size))
+    {
+        aligned_free(buf);
+        return NULL;
+    }
+
+    return buf;
+}
+
+void *dma_buf_alloc_uncached(size_t size)
+{
+    void *buf = dma_buf_alloc(size);
+
+    if (!buf)
+    {
+        return NULL;
+    }
+
+    /*
+     * 清除 cache 中的旧数据, 以后不会再有脏的 cache line 写回覆盖 DMA 数据
+     */
+    dma_cache_invalidate(buf, align_up(size, DMA_CACHE_LINE));
+
+    return dma_buf_to_uncached(buf);
+}
+
+void dma_buf_free(void *buf)
+{
+    if (buf)
+    {
+        aligned_free(dma_buf_to_cached(buf));
+    }
+}
+
@@ -0,0 +1,78 @@
+#ifndef RB_HAL_DMA_BUF_H
+#define RB_HAL_DMA_BUF_H
+
+/*
+ * dma_buf.h - DMA 缓冲区
+ *
+ * 地址窗口 (见 ld.script):
+ *   CACHED:   0x9000000000000000 | 物理地址
+ *   UNCACHED: 0x8000000000000000 | 物理地址
+ *
+ * 缓冲区按 cache line 对齐, 长度按 cache line 取整, 不会和其它数据共用
+ * cache line. 两种用法:
+ *
+ *   dma_buf_alloc():          cache 地址, 启动 DMA 前调用 dma_cache_flush(),
+ *                             DMA 写完后调用 dma_cache_invalidate() 再读.
+ *   dma_buf_alloc_uncached(): uncache 地址, CPU 和 DMA 直接共享, 不需要维护.
+ *
+ * 设备使用 dma_buf_phys() 得到的物理地址. 分配的缓冲区整个在 4G 以下, 否则
+ * 分配失败, 32 位地址的 DMA 控制器也可以使用.
+ *
+ * LoongArch 的 cacop 没有只作废不写回的 hit 操作, dma_cache_invalidate() 也
+ * 会写回脏的 cache line: DMA 写入期间 CPU 不能写这块缓冲区, 否则写回的数据
+ * 覆盖 DMA 的数据.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DMA_CACHE_LINE          64
+
+#define DMA_ADDR_CACHED         0x9000000000000000ULL
+#define DMA_ADDR_UNCACHED       0x8000000000000000ULL
+#define DMA_ADDR_PHYS_MASK      0x0000FFFFFFFFFFFFULL
+#define DMA_ADDR_LIMIT32        0x0000000100000000ULL
+
+void *dma_buf_alloc(size_t size);
+void *dma_buf_alloc_uncached(size_t size);
+void dma_buf_free(void *buf);                   /* cache or uncache 地址都可以 */
+
+void dma_cache_flush(const void *addr, size_t size);         /* 写回, CPU→设备 */
+void dma_cache_invalidate(const void *addr, size_t size);    /* 写回并作废, 设备→CPU */
+
+static inline uint64_t dma_buf_phys(const void *buf)
+{
+    return (uint64_t)(size_t)buf & DMA_ADDR_PHYS_MASK;
+}
+
+/*
+ * 缓冲区整个在 4G 以下, 32 位地址的 DMA 控制器 (如 APB DMA) 可以访问
+ */
+static inline int dma_buf_is32(const void *buf, size_t size)
+{
+    return dma_buf_phys(buf) + size <= DMA_ADDR_LIMIT32;
+}
+
+/*
+ * 32 位地址的 DMA 控制器使用. 不是 dma_buf_alloc() 分配的缓冲区要先用
+ * dma_buf_is32() 检查, 超过 4G 返回 0
+ */
+static inline uint32_t dma_buf_phys32(const void *buf)
+{
+    uint64_t phys = dma_buf_phys(buf);
+
+    return phys >> 32 ? 0 : (uint32_t)phys;
+}
+
+static inline void *dma_buf_to_uncached(const void *buf)
+{
+    return (void *)(size_t)(dma_buf_phys(buf) | DMA_ADDR_UNCACHED);
+}
+
+static inline void *dma_buf_to_cached(const void *buf)
+{
+    return (void *)(size_t)(dma_buf_phys(buf) | DMA_ADDR_CACHED);
+}
+
+#endif // RB_HAL_DMA_BUF_H
+
@@ -1,7 +1,7 @@
-﻿#ifndef RB_HAL_GPIO_H
-#define RB_HAL_GPIO_H
-
-void gpio_init(void);
-
-#endif // RB_HAL_GPIO_H
-
+﻿#ifndef RB_HAL_GPIO_H
+#define RB_HAL_GPIO_H
+
+void gpio_init(void);
+
+#endif // RB_HAL_GPIO_H
+
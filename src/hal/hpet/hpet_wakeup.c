@@ -0,0 +1,79 @@
+/*
+ * hpet_wakeup.c - 空闲唤醒定时器
+ *
+ * 功能说明:
+ *   pesudo_idle() 计算出下一个任务就绪的时间后, 调用 pesudo_idle_timer_arm()
+ *   设置 HPET 单次定时, 然后 CPU 执行 "idle 0" 等待中断. 定时到期的中断
+ *   唤醒 CPU, 中断处理中不需要做别的事情.
+ *
+ *   退出空闲时 (其它中断唤醒了任务) 调用 pesudo_idle_timer_cancel() 停止.
+ */
+
+#include "bsp.h"
+#include "hpet_wakeup.h"
+#include "pesudo_idle.h"
+
+#if BSP_USE_HPET3
+
+#include "ls2k_hpet.h"
+
+static volatile int m_armed = 0;
+
+static void hpet_wakeup_callback(void *hpet, int *stop)
+{
+    (void)hpet;
+
+    /*
+     * 单次, 到期后停止
+     */
+    m_armed = 0;
+    *stop = 1;
+}
+
+int pesudo_idle_timer_arm(uint32_t us)
+{
+    hpet_cfg_t cfg;
+
+    if (us == 0)
+    {
+        return -1;
+    }
+
+    /*
+     * interval_ns 是 32 位
+     */
+    if (us > HPET_WAKEUP_MAX_US)
+    {
+        us = HPET_WAKEUP_MAX_US;
+    }
+
+    if (m_armed)
+    {
+        ls2k_hpet_timer_stop(HPET_WAKEUP_DEV);
+    }
+
+    cfg.mode        = HPET_ONESHOT_TIMER;
+    cfg.interval_ns = us * 1000;
+    cfg.callback    = hpet_wakeup_callback;
+
+    if (ls2k_hpet_timer_start(HPET_WAKEUP_DEV, &cfg) != 0)
+    {
+        return -1;
+    }
+
+    m_armed = 1;
+
+    return 0;
+}
+
+void pesudo_idle_timer_cancel(void)
+{
+    if (m_armed)
+    {
+        ls2k_hpet_timer_stop(HPET_WAKEUP_DEV);
+        m_armed = 0;
+    }
+}
+
+#endif // #if BSP_USE_HPET3
+
@@ -0,0 +1,17 @@
+#ifndef RB_HAL_HPET_WAKEUP_H
+#define RB_HAL_HPET_WAKEUP_H
+
+/*
+ * hpet_wakeup.h - 空闲唤醒定时器
+ *
+ * 使用 HPET3 单次定时, 在主循环空闲 (pesudo_idle) 的截止时间产生中断,
+ * 唤醒 "idle 0" 中的 CPU. 实现 pesudo_idle_timer_arm/cancel(), 链接本模块
+ * 后覆盖 pesudo_idle.c 中的弱定义.
+ */
+
+#include <stdint.h>
+
+#define HPET_WAKEUP_DEV         devHPET3
+#define HPET_WAKEUP_MAX_US      4000000
+
+#endif // RB_HAL_HPET_WAKEUP_H
@@ -0,0 +1,411 @@
+/*
+ * hrtimer.c - 高精度定时器 (us)
+ *
+ * 功能说明:
+ *   舵机步进 (readar_rotate.c) 需要不随 ms clock tick 抖动的定时,
+ *   ms 的 clock tick 和 libbsp 的 Timer 不够用.
+ *
+ *   定时器链表按到期时间 (stable counter) 排序, HPET0 单次定时到表头的
+ *   到期时间. 中断中停止比较器, 推迟一次 hrtimer_expire() 到主循环;
+ *   hrtimer_expire() 取出全部到期的定时器, 调用回调函数, 再设置比较器.
+ *
+ *   链表只在主循环中修改 (任务, 回调函数), 中断只读写 m_posted/m_armed.
+ *   defer 队列满时中断以 HRTIMER_MIN_NS 重新定时, 下次中断再推迟, 不丢失
+ *   到期.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bsp.h"
+#include "osal.h"
+#include "hrtimer.h"
+
+#if BSP_USE_HPET0
+
+#include "ls2k_hpet.h"
+#include "pesudo_defer.h"
+#include "stable_counter.h"
+
+typedef struct hrtimer
+{
+    char      name[HRTIMER_NAME_MAX];
+    osal_task_entry_t handler;
+    void     *arg;
+
+    uint32_t  timeout_us;
+    uint32_t  is_period;
+    uint32_t  active;                           /* 在 m_head 链表中 */
+    uint64_t  expire;                           /* 到期时间, stable counter */
+    uint64_t  period;                           /* stable counter */
+
+    uint32_t  fires;
+    uint32_t  skipped;
+    uint32_t  late_max_us;
+
+    struct hrtimer *next;                       /* 按到期时间排序 */
+    struct hrtimer *next_all;                   /* 全部定时器 */
+} hrtimer_t;
+
+static hrtimer_t *m_head = NULL;
+static hrtimer_t *m_all  = NULL;
+
+static volatile int m_armed  = 0;               /* 比较器在定时 */
+static volatile int m_posted = 0;               /* hrtimer_expire() 已推迟 */
+static volatile uint32_t m_retries = 0;         /* defer 队列满, 重新定时 */
+
+static void hrtimer_expire(void *arg);
+static void hrtimer_isr(void *hpet, int *stop);
+
+//-----------------------------------------------------------------------------
+
+static void hrtimer_insert(hrtimer_t *t)
+{
+    hrtimer_t **pp = &m_head;
+
+    /*
+     * 相同到期时间的排在后面
+     */
+    while (*pp && ((int64_t)((*pp)->expire - t->expire) <= 0))
+    {
+        pp = &(*pp)->next;
+    }
+
+    t->next   = *pp;
+    *pp       = t;
+    t->active = 1;
+}
+
+static void hrtimer_remove(hrtimer_t *t)
+{
+    hrtimer_t **pp = &m_head;
+
+    while (*pp && (*pp != t))
+    {
+        pp = &(*pp)->next;
+    }
+
+    if (*pp)
+    {
+        *pp = t->next;
+    }
+
+    t->next   = NULL;
+    t->active = 0;
+}
+
+/*
+ * 在临界区或中断中调用
+ */
+static int hrtimer_arm(uint32_t ns)
+{
+    hpet_cfg_t cfg;
+
+    cfg.mode        = HPET_ONESHOT_TIMER;
+    cfg.interval_ns = ns;
+    cfg.callback    = hrtimer_isr;
+
+    if (ls2k_hpet_timer_start(HRTIMER_DEV, &cfg) != 0)
+    {
+        return -1;
+    }
+
+    m_armed = 1;
+    return 0;
+}
+
+static void hrtimer_isr(void *hpet, int *stop)
+{
+    (void)hpet;
+
+    *stop   = 1;
+    m_armed = 0;
+
+    if (m_posted)
+    {
+        return;
+    }
+
+    m_posted = 1;
+    if (pesudo_defer_call(hrtimer_expire, NULL) == 0)
+    {
+        return;
+    }
+
+    /*
+     * 队列满, 最短时间后再试, 到期的定时器还在表中
+     */
+    m_posted = 0;
+    m_retries++;
+
+    if (hrtimer_arm(HRTIMER_MIN_NS) == 0)
+    {
+        *stop = 0;
+    }
+}
+
+/*
+ * 比较器定时到表头的到期时间
+ */
+static void hrtimer_program(void)
+{
+    uint64_t now, ns;
+    size_t flag;
+
+    flag = osal_enter_critical_section();
+
+    if (m_armed)
+    {
+        ls2k_hpet_timer_stop(HRTIMER_DEV);
+        m_armed = 0;
+    }
+
+    if (m_head && !m_posted)
+    {
+        now = stable_counter_read();
+
+        if ((int64_t)(m_head->expire - now) <= 0)
+            ns = HRTIMER_MIN_NS;
+        else
+            ns = stable_counter_to_ns(m_head->expire - now);
+
+        if (ns < HRTIMER_MIN_NS)
+            ns = HRTIMER_MIN_NS;
+        else if (ns > HRTIMER_MAX_NS)
+            ns = HRTIMER_MAX_NS;                /* 到时再定时剩余的时间 */
+
+        hrtimer_arm((uint32_t)ns);
+    }
+
+    osal_leave_critical_section(flag);
+}
+
+/*
+ * 主循环中执行, 回调函数中可以启动, 停止或删除定时器
+ */
+static void hrtimer_expire(void *arg)
+{
+    hrtimer_t *t;
+    osal_task_entry_t handler;
+    void *harg;
+    uint64_t now, n;
+    uint32_t late;
+
+    (void)arg;
+
+    m_posted = 0;
+
+    for (;;)
+    {
+        now = stable_counter_read();
+
+        t = m_head;
+        if (!t || ((int64_t)(t->expire - now) > 0))
+        {
+            break;
+        }
+
+        hrtimer_remove(t);
+
+        late = (uint32_t)stable_counter_to_us(now - t->expire);
+        if (late > t->late_max_us)
+            t->late_max_us = late;
+        t->fires++;
+
+        if (t->is_period)
+        {
+            t->expire += t->period;
+
+            /*
+             * 落后一个周期以上, 跳过错过的到期, 不连续回调
+             */
+            if ((int64_t)(now - t->expire) >= 0)
+            {
+                n = (now - t->expire) / t->period + 1;
+                t->expire  += n * t->period;
+                t->skipped += (uint32_t)n;
+            }
+
+            hrtimer_insert(t);
+        }
+
+        /*
+         * 回调后 t 可能已被删除
+         */
+        handler = t->handler;
+        harg    = t->arg;
+        handler(harg);
+    }
+
+    hrtimer_program();
+}
+
+//-----------------------------------------------------------------------------
+// osal
+//-----------------------------------------------------------------------------
+
+osal_hrtimer_t osal_hrtimer_create(const char *name,
+                                   osal_task_entry_t handler,
+                                   void *argument,
+                                   uint32_t timeout_us,
+                                   bool is_period)
+{
+    hrtimer_t *t;
+
+    if (!handler)
+    {
+        return NULL;
+    }
+
+    t = (hrtimer_t *)calloc(1, sizeof(hrtimer_t));
+    if (!t)
+    {
+        LOG_ERR(STR_OSAL_CREATE_TIMER_FAIL, name ? name : "hrtimer");
+        return NULL;
+    }
+
+    if (name)
+    {
+        strncpy(t->name, name, HRTIMER_NAME_MAX - 1);
+    }
+
+    t->handler    = handler;
+    t->arg        = argument;
+    t->timeout_us = timeout_us;
+    t->is_period  = is_period ? 1 : 0;
+
+    t->next_all = m_all;
+    m_all       = t;
+
+    return (osal_hrtimer_t)t;
+}
+
+void osal_hrtimer_delete(osal_hrtimer_t timer)
+{
+    hrtimer_t *t = (hrtimer_t *)timer;
+    hrtimer_t **pp = &m_all;
+
+    if (!t)
+    {
+        return;
+    }
+
+    osal_hrtimer_stop(timer);
+
+    while (*pp && (*pp != t))
+    {
+        pp = &(*pp)->next_all;
+    }
+
+    if (*pp)
+    {
+        *pp = t->next_all;
+    }
+
+    free(t);
+}
+
+int osal_hrtimer_start(osal_hrtimer_t timer, uint32_t timeout_us)
+{
+    hrtimer_t *t = (hrtimer_t *)timer;
+    uint64_t ticks;
+
+    if (!t)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    if (timeout_us)
+    {
+        t->timeout_us = timeout_us;
+    }
+
+    ticks = stable_counter_from_us(t->timeout_us);
+    if (ticks == 0)
+    {
+        return OSAL_ERR_INVAL;
+    }
+
+    if (t->active)
+    {
+        hrtimer_remove(t);
+    }
+
+    t->period = ticks;
+    t->expire = stable_counter_read() + ticks;
+    hrtimer_insert(t);
+
+    /*
+     * 成为表头, 比较器要提前
+     */
+    if (m_head == t)
+    {
+        hrtimer_program();
+    }
+
+    return OSAL_ERR_OK;
+}
+
+void osal_hrtimer_stop(osal_hrtimer_t timer)
+{
+    hrtimer_t *t = (hrtimer_t *)timer;
+    int head;
+
+    if (!t || !t->active)
+    {
+        return;
+    }
+
+    head = (m_head == t);
+    hrtimer_remove(t);
+
+    if (head)
+    {
+        hrtimer_program();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Report
+//-----------------------------------------------------------------------------
+
+int hrtimer_report(hrtimer_info_t *info, int max)
+{
+    hrtimer_t *t;
+    int count = 0;
+
+    for (t = m_all; t && (count < max); t = t->next_all)
+    {
+        memcpy(info[count].name, t->name, HRTIMER_NAME_MAX);
+        info[count].timeout_us  = t->timeout_us;
+        info[count].period      = t->is_period;
+        info[count].active      = t->active;
+        info[count].fires       = t->fires;
+        info[count].skipped     = t->skipped;
+        info[count].late_max_us = t->late_max_us;
+        count++;
+    }
+
+    return count;
+}
+
+uint32_t hrtimer_retries(void)
+{
+    return m_retries;
+}
+
+void hrtimer_stats_reset(void)
+{
+    hrtimer_t *t;
+
+    m_retries = 0;
+
+    for (t = m_all; t; t = t->next_all)
+    {
+        t->fires       = 0;
+        t->skipped     = 0;
+        t->late_max_us = 0;
+    }
+}
+
+#endif // #if BSP_USE_HPET0
@@ -0,0 +1,45 @@
+#ifndef RB_HAL_HPET_HRTIMER_H
+#define RB_HAL_HPET_HRTIMER_H
+
+/*
+ * hrtimer.h - 高精度定时器 (us)
+ *
+ * 实现 osal.h 中的 osal_hrtimer_*(). 所有定时器按到期时间排序, 共用
+ * HPET0 一个比较器, 单次定时到最早的到期时间. 中断中只把到期处理推迟到
+ * 主循环 (pesudo_defer_call), 在主循环中调用回调函数, 周期定时器按周期
+ * 累加到期时间, 然后重新设置比较器.
+ *
+ * HPET3 用于空闲唤醒 (hpet_wakeup.c).
+ */
+
+#include <stdint.h>
+
+#define HRTIMER_DEV             devHPET0
+#define HRTIMER_MIN_NS          2000            /* 比较器最小定时 */
+#define HRTIMER_MAX_NS          4000000000U     /* interval_ns 是 32 位 */
+#define HRTIMER_NAME_MAX        16
+
+typedef struct hrtimer_info
+{
+    char      name[HRTIMER_NAME_MAX];
+    uint32_t  timeout_us;
+    uint32_t  period;                           /* 周期定时器 */
+    uint32_t  active;
+    uint32_t  fires;                            /* 回调次数 */
+    uint32_t  skipped;                          /* 落后跳过的周期 */
+    uint32_t  late_max_us;                      /* 到期到回调的最长延迟 */
+} hrtimer_info_t;
+
+/*
+ * fill at most max timers, return the count filled
+ */
+int hrtimer_report(hrtimer_info_t *info, int max);
+
+/*
+ * times the defer queue was full in the interrupt, the comparator was armed
+ * again with HRTIMER_MIN_NS
+ */
+uint32_t hrtimer_retries(void);
+void hrtimer_stats_reset(void);
+
+#endif // RB_HAL_HPET_HRTIMER_H
@@ -0,0 +1,593 @@
+/*
+ * shell_cmds.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * 应用添加的 shell 命令
+ *
+ * 命令通过 shell_add_cmd() 注册到 BSP 库的 shell, 若库中没有该函数(弱引用
+ * 为 NULL), 则不注册, 不影响链接.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bsp.h"
+
+#if BSP_USE_SHELL
+
+#include "memory_man.h"
+#include "pesudo_idle.h"
+#include "pesudo_ctx.h"
+#include "pesudo_defer.h"
+#include "pesudo_sched.h"
+#include "pesudo_prof.h"
+#include "pesudo_stack.h"
+#include "pesudo_topic.h"
+#include "stable_counter.h"
+#include "hrtimer.h"
+#include "uart_dma.h"
+
+extern void printk(const char *fmt, ...);
+
+typedef int (*shell_cmd_func_t)(int argc, char **argv);
+
+extern int shell_add_cmd(const char *name, const char *usage, shell_cmd_func_t func)
+    __attribute__((weak));
+
+//-----------------------------------------------------------------------------
+// heap, memory_man.c 只在不使用文件系统时编译
+//-----------------------------------------------------------------------------
+
+#if !BSP_USE_FS
+
+#if HEAP_TRACE
+
+/*
+ * 每次写一行 "HT:" + 16 进制, tools/heap_trace 从控制台日志中解码
+ */
+static int heap_trace_write_hex(const void *buf, int len, void *arg)
+{
+    static const char hexval[] = "0123456789ABCDEF";
+    const unsigned char *p = (const unsigned char *)buf;
+    char line[2 * 32 + 1];
+    int i, n;
+
+    for (i = 0; i < len; i += n)
+    {
+        int j;
+
+        n = len - i > 32 ? 32 : len - i;
+
+        for (j = 0; j < n; j++)
+        {
+            line[2*j]   = hexval[p[i+j] >> 4];
+            line[2*j+1] = hexval[p[i+j] & 0x0F];
+        }
+        line[2*n] = '\0';
+
+        printk("HT:%s\r\n", line);
+    }
+
+    return len;
+}
+
+/*
+ * heap trace start [records] - 开始记录, 缓冲区记录数为 2 的幂, 默认 4096
+ * heap trace stop            - 停止记录
+ * heap trace dump            - 停止并输出到控制台
+ * heap trace release         - 释放缓冲区
+ */
+static int shell_cmd_heap_trace(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        printk("usage: heap trace start [records]|stop|dump|release\r\n");
+        return -1;
+    }
+
+    if (strcmp(argv[2], "start") == 0)
+    {
+        unsigned int records = argc > 3 ? (unsigned int)strtoul(argv[3], NULL, 0) : 4096;
+
+        if (heap_trace_start(records) != 0)
+        {
+            printk("heap trace start fail\r\n");
+            return -1;
+        }
+    }
+    else if (strcmp(argv[2], "stop") == 0)
+    {
+        heap_trace_stop();
+    }
+    else if (strcmp(argv[2], "dump") == 0)
+    {
+        heap_trace_stop();
+        printk("heap trace: %i records\r\n", heap_trace_dump(heap_trace_write_hex, NULL));
+    }
+    else if (strcmp(argv[2], "release") == 0)
+    {
+        heap_trace_release();
+    }
+
+    return 0;
+}
+
+#endif // #if HEAP_TRACE
+
+/*
+ * heap          - 显示统计
+ * heap reset    - 清除计数, 直方图和峰值
+ * heap verify   - 检查堆链表
+ * heap trace    - 分配记录
+ */
+static int shell_cmd_heap(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        heap_stats_show();
+        return 0;
+    }
+
+    if (strcmp(argv[1], "reset") == 0)
+    {
+        heap_stats_reset();
+    }
+    else if (strcmp(argv[1], "verify") == 0)
+    {
+        printk("faulty blocks: %i\r\n", heap_verify_faulty_blocks());
+    }
+#if HEAP_TRACE
+    else if (strcmp(argv[1], "trace") == 0)
+    {
+        return shell_cmd_heap_trace(argc, argv);
+    }
+#endif
+    else
+    {
+        printk("usage: heap [reset|verify|trace]\r\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+#endif // #if !BSP_USE_FS
+
+//-----------------------------------------------------------------------------
+// idle
+//-----------------------------------------------------------------------------
+
+/*
+ * idle          - 显示主循环空闲时间, 即 CPU 余量
+ * idle reset    - 重新统计
+ */
+static int shell_cmd_idle(int argc, char **argv)
+{
+    pesudo_idle_stats_t st;
+    unsigned long permille;
+
+    if ((argc >= 2) && (strcmp(argv[1], "reset") == 0))
+    {
+        pesudo_idle_stats_reset();
+        return 0;
+    }
+
+    pesudo_idle_stats(&st);
+
+    permille = st.total_us ? (unsigned long)(st.idle_us * 1000 / st.total_us) : 0;
+
+    printk("idle: %lu.%lu%% of %lu ms, %u times, max %u us\r\n",
+           permille / 10, permille % 10,
+           (unsigned long)(st.total_us / 1000),
+           st.idle_count, st.idle_max_us);
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// defer
+//-----------------------------------------------------------------------------
+
+/*
+ * defer         - 中断推迟操作的统计
+ * defer reset   - 重新统计
+ */
+static int shell_cmd_defer(int argc, char **argv)
+{
+    pesudo_defer_stats_t st;
+
+    if ((argc >= 2) && (strcmp(argv[1], "reset") == 0))
+    {
+        pesudo_defer_stats_reset();
+        return 0;
+    }
+
+    pesudo_defer_stats(&st);
+
+    printk("defer: posted %u, done %u, overflow %u, max used %u/%u\r\n",
+           st.posted, st.done, st.overflow, st.max_used, PESUDO_DEFER_SIZE);
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// period
+//-----------------------------------------------------------------------------
+
+/*
+ * period        - 周期任务的抖动, 运行时间和超时次数 (us)
+ * period reset  - 重新统计
+ */
+static int shell_cmd_period(int argc, char **argv)
+{
+    psched_task_t *task;
+    psched_period_stats_t st;
+    int reset = (argc >= 2) && (strcmp(argv[1], "reset") == 0);
+
+    if (!reset)
+    {
+        printk("%-16s %8s %8s %10s %7s %7s %7s %7s %6s %6s\r\n",
+               "name", "period", "deadline", "releases", "jit.avg", "jit.max",
+               "exe.avg", "exe.max", "miss", "skip");
+    }
+
+    for (task = psched_task_list_first(); task; task = psched_task_list_next(task))
+    {
+        if (reset)
+        {
+            psched_task_period_stats_reset(task);
+            continue;
+        }
+
+        if (psched_task_period_stats(task, &st) != 0)
+        {
+            continue;
+        }
+
+        printk("%-16s %8u %8u %10u %7u %7u %7u %7u %6u %6u\r\n",
+               task->name, st.period_us, st.deadline_us, st.releases,
+               st.releases ? (unsigned)(st.jitter_sum_us / st.releases) : 0,
+               st.jitter_max_us,
+               st.releases ? (unsigned)(st.exec_sum_us / st.releases) : 0,
+               st.exec_max_us, st.misses, st.skipped);
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// top
+//-----------------------------------------------------------------------------
+
+#define TOP_TASKS_MAX           24
+
+static pesudoos_task_stats_t m_top_cur[TOP_TASKS_MAX];
+static pesudoos_task_stats_t m_top_prev[TOP_TASKS_MAX];
+static int m_top_prev_count = 0;
+
+static uint64_t m_top_last = 0;                 /* 上次采样, stable counter */
+static uint64_t m_top_idle_us = 0;
+
+static psched_timer_t *m_top_timer = NULL;
+static int m_top_remain = 0;                    /* 剩余刷新次数, 0: 一直刷新 */
+
+static const pesudoos_task_stats_t *top_find_prev(const void *task)
+{
+    int i;
+
+    for (i=0; i<m_top_prev_count; i++)
+    {
+        if (m_top_prev[i].task == task)
+            return &m_top_prev[i];
+    }
+
+    return NULL;
+}
+
+/*
+ * 和上次采样的差值: 时间段内的 cpu 占用, 平均运行时间和阻塞时间.
+ * max 是本时间段内的
+ */
+static void top_print(void)
+{
+    static const pesudoos_task_stats_t zero;
+    const pesudoos_task_stats_t *cur, *prev;
+    pesudo_idle_stats_t idle;
+    uint64_t now, elapsed, run, permille;
+    uint32_t runs;
+    int i, n;
+
+    now = stable_counter_read();
+    elapsed = stable_counter_to_us(m_top_last ? now - m_top_last : now);
+    if (elapsed == 0)
+    {
+        elapsed = 1;
+    }
+
+    n = pesudoos_task_stats(m_top_cur, TOP_TASKS_MAX);
+    pesudo_idle_stats(&idle);
+
+    permille = (idle.idle_us - m_top_idle_us) * 1000 / elapsed;
+
+    printk("top: %lu ms, idle %lu.%lu%%\r\n",
+           (unsigned long)(elapsed / 1000),
+           (unsigned long)(permille / 10), (unsigned long)(permille % 10));
+    printk("%-16s %4s %6s %7s %7s %7s %8s %8s %8s %8s %8s\r\n",
+           "name", "prio", "cpu%", "runs", "avg.us", "max.us", "wake.max",
+           "sleep.ms", "sem.ms", "event.ms", "mq.ms");
+
+    for (i=0; i<n; i++)
+    {
+        cur  = &m_top_cur[i];
+        prev = top_find_prev(cur->task);
+        if (!prev)
+        {
+            prev = &zero;
+        }
+
+        run  = cur->run_us - prev->run_us;
+        runs = cur->run_count - prev->run_count;
+        permille = run * 1000 / elapsed;
+
+        if (cur->kind == PESUDO_STATS_PSCHED)
+            printk("%-16s %4u ", cur->name, cur->prio);
+        else
+            printk("%-16s %4s ", cur->name, "-");
+
+        printk("%3lu.%lu%% %7u %7lu %7u %8u %8lu %8lu %8lu %8lu\r\n",
+               (unsigned long)(permille / 10), (unsigned long)(permille % 10),
+               runs, (unsigned long)(runs ? run / runs : 0),
+               cur->run_max_us, cur->wake_max_us,
+               (unsigned long)((cur->block_us[PSCHED_BLOCK_SLEEP] - prev->block_us[PSCHED_BLOCK_SLEEP]) / 1000),
+               (unsigned long)((cur->block_us[PSCHED_BLOCK_SEM]   - prev->block_us[PSCHED_BLOCK_SEM]) / 1000),
+               (unsigned long)((cur->block_us[PSCHED_BLOCK_EVENT] - prev->block_us[PSCHED_BLOCK_EVENT]) / 1000),
+               (unsigned long)((cur->block_us[PSCHED_BLOCK_MQ]    - prev->block_us[PSCHED_BLOCK_MQ]) / 1000));
+    }
+
+    memcpy(m_top_prev, m_top_cur, sizeof(pesudoos_task_stats_t) * n);
+    m_top_prev_count = n;
+    m_top_last = now;
+    m_top_idle_us = idle.idle_us;
+
+    pesudoos_task_stats_reset_max();
+}
+
+static void top_timer_callback(void *arg)
+{
+    (void)arg;
+
+    top_print();
+
+    if (m_top_remain && (--m_top_remain == 0))
+    {
+        psched_timer_stop(m_top_timer);
+    }
+}
+
+/*
+ * top                   - 显示一次, 从上次 top 到现在
+ * top interval [count]  - 每 interval ms 刷新, count 次后停止, 0 一直刷新
+ * top stop              - 停止刷新
+ */
+static int shell_cmd_top(int argc, char **argv)
+{
+    uint32_t interval;
+
+    if (argc < 2)
+    {
+        top_print();
+        return 0;
+    }
+
+    if (strcmp(argv[1], "stop") == 0)
+    {
+        if (m_top_timer)
+        {
+            psched_timer_stop(m_top_timer);
+        }
+        return 0;
+    }
+
+    interval = (uint32_t)strtoul(argv[1], NULL, 0);
+    if (interval == 0)
+    {
+        printk("usage: top [interval_ms [count] | stop]\r\n");
+        return -1;
+    }
+
+    m_top_remain = (argc >= 3) ? (int)strtoul(argv[2], NULL, 0) : 0;
+
+    if (!m_top_timer)
+    {
+        m_top_timer = psched_timer_create("top", top_timer_callback, NULL, interval, true);
+        if (!m_top_timer)
+        {
+            return -1;
+        }
+    }
+
+    /*
+     * 从现在开始统计
+     */
+    top_print();
+    psched_timer_start(m_top_timer, interval);
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// stack
+//-----------------------------------------------------------------------------
+
+/*
+ * stack         - 各任务堆栈大小和最多使用, 用于确定堆栈大小
+ */
+static int shell_cmd_stack(int argc, char **argv)
+{
+    pesudo_stack_info_t info[TOP_TASKS_MAX];
+    int i, n;
+
+    (void)argc;
+    (void)argv;
+
+    n = pesudo_stack_report(info, TOP_TASKS_MAX);
+
+    printk("%-16s %6s %6s %6s %5s\r\n", "name", "size", "used", "free", "used%");
+
+    for (i=0; i<n; i++)
+    {
+        if (info[i].used == 0)
+        {
+            printk("%-16s %6u %6s %6s %5s\r\n", info[i].name, info[i].size, "-", "-", "-");
+            continue;
+        }
+
+        printk("%-16s %6u %6u %6u %4u%%%s\r\n", info[i].name, info[i].size,
+               info[i].used, info[i].size - info[i].used,
+               info[i].used * 100 / info[i].size,
+               info[i].overflow ? "  OVERFLOW" : "");
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// hrtimer
+//-----------------------------------------------------------------------------
+
+#if BSP_USE_HPET0
+
+#define HRTIMER_SHOW_MAX        16
+
+/*
+ * hrtimer       - 高精度定时器的回调次数和延迟 (us)
+ * hrtimer reset - 重新统计
+ */
+static int shell_cmd_hrtimer(int argc, char **argv)
+{
+    hrtimer_info_t info[HRTIMER_SHOW_MAX];
+    int i, n;
+
+    if ((argc >= 2) && (strcmp(argv[1], "reset") == 0))
+    {
+        hrtimer_stats_reset();
+        return 0;
+    }
+
+    n = hrtimer_report(info, HRTIMER_SHOW_MAX);
+
+    printk("%-16s %10s %6s %6s %10s %6s %8s\r\n",
+           "name", "timeout", "period", "active", "fires", "skip", "late.max");
+
+    for (i=0; i<n; i++)
+    {
+        printk("%-16s %10u %6s %6s %10u %6u %8u\r\n", info[i].name,
+               info[i].timeout_us, info[i].period ? "yes" : "no",
+               info[i].active ? "yes" : "no", info[i].fires,
+               info[i].skipped, info[i].late_max_us);
+    }
+
+    printk("defer full, retries: %u\r\n", hrtimer_retries());
+
+    return 0;
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+// topic
+//-----------------------------------------------------------------------------
+
+/*
+ * topic         - 主题的发布次数, 各订阅的队列和丢弃的消息, 串口没有发送的扫描
+ */
+static int shell_cmd_topic(int argc, char **argv)
+{
+    topic_t *topic;
+    topic_sub_t *sub;
+
+    (void)argc;
+    (void)argv;
+
+    printk("%-16s %6s %5s %10s %8s\r\n", "name", "size", "count", "published", "nobuf");
+
+    for (topic = topic_list_first(); topic; topic = topic_list_next(topic))
+    {
+        printk("%-16s %6u %5u %10u %8u\r\n", topic->name, topic->msg_size,
+               topic->msg_count, topic->published, topic->no_buffer);
+
+        for (sub = topic->subs; sub; sub = sub->next)
+        {
+            printk("  sub %-10s depth %2u queued %2u received %10u dropped %8u\r\n",
+                   sub->policy == TOPIC_POLICY_DROP_NEWEST ? "newest" : "oldest",
+                   sub->depth, sub->count, sub->received, sub->dropped);
+        }
+    }
+
+    printk("uart dma dropped %u\r\n", uart_dma_dropped());
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// ctxbench
+//-----------------------------------------------------------------------------
+
+/*
+ * ctxbench [loops] - pesudo_ctx_switch() 和 setjmp/longjmp 切换耗时
+ */
+static int shell_cmd_ctxbench(int argc, char **argv)
+{
+    pesudo_ctx_bench_t res;
+    uint32_t loops = 100000;
+
+    if (argc >= 2)
+    {
+        loops = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    if (pesudo_ctx_bench(loops, &res) != 0)
+    {
+        printk("usage: ctxbench [loops]\r\n");
+        return -1;
+    }
+
+    printk("ctxbench: %u loops, ctx switch %u ns, setjmp/longjmp %u ns\r\n",
+           res.loops, res.ctx_ns, res.jmp_ns);
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void shell_cmds_register(void)
+{
+    if (!shell_add_cmd)
+    {
+        return;
+    }
+
+#if !BSP_USE_FS
+    shell_add_cmd("heap", "heap [reset|verify|trace], show heap statistics", shell_cmd_heap);
+#endif
+    shell_add_cmd("idle", "idle [reset], show idle time of main loop", shell_cmd_idle);
+    shell_add_cmd("defer", "defer [reset], show isr deferred operations", shell_cmd_defer);
+    shell_add_cmd("period", "period [reset], show jitter and deadline miss of periodic tasks", shell_cmd_period);
+    shell_add_cmd("top", "top [interval_ms [count] | stop], show cpu time of tasks", shell_cmd_top);
+    shell_add_cmd("stack", "stack, show stack usage of tasks", shell_cmd_stack);
+#if BSP_USE_HPET0
+    shell_add_cmd("hrtimer", "hrtimer [reset], show latency of high resolution timers", shell_cmd_hrtimer);
+#endif
+    shell_add_cmd("topic", "topic, show publish and drops of topics", shell_cmd_topic);
+    shell_add_cmd("ctxbench", "ctxbench [loops], time of task context switch", shell_cmd_ctxbench);
+}
+
+#endif // #if BSP_USE_SHELL
+
+/*
+ * @@ END
+ */
@@ -0,0 +1,48 @@
+/*
+ * ctx_bench.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Host tool, switch cost of pesudo_ctx_switch() and setjmp()/longjmp(), the
+ * same as shell command "ctxbench" on the board.
+ *
+ * build:  gcc -O2 -U_FORTIFY_SOURCE -I../../BareMetal/PesudoOS -I../../include
+ *             -o ctx_bench ctx_bench.c ../../BareMetal/PesudoOS/pesudo_ctx.c
+ * usage:  ctx_bench [loops]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pesudo_ctx.h"
+
+unsigned long get_clock_ticks(void)
+{
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    pesudo_ctx_bench_t result;
+    uint32_t loops = 1000000;
+
+    if (argc > 1)
+    {
+        loops = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    if (pesudo_ctx_bench(loops, &result) != 0)
+    {
+        fprintf(stderr, "bench fail\n");
+        return 1;
+    }
+
+    printf("loops:             %u\n", result.loops);
+    printf("pesudo_ctx_switch: %u ns\n", result.ctx_ns);
+    printf("setjmp + longjmp:  %u ns\n", result.jmp_ns);
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+/*
+ * bsp.h
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Host build of ls2k300/misc/memory_man.c for heap_bench, in place of
+ * include/bsp.h: without file system, so the heap of memory_man.c is built.
+ * The guard is the one of include/bsp.h, memory_man.h includes "bsp.h" from
+ * its own directory and gets nothing more.
+ */
+
+#ifndef _BSP_H
+#define _BSP_H
+
+#define BSP_USE_FS      0
+
+#endif // _BSP_H
+
+/*
+ * @@ END
+ */
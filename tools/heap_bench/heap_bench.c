@@ -0,0 +1,229 @@
+/*
+ * heap_bench.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Host tool, latency of malloc()/free() of memory_man.c (TLSF) in a host
+ * buffer, with a mixed workload: random slots are allocated or freed, the
+ * sizes are mostly small, some medium and a few large, like the board.
+ *
+ * build:  gcc -O2 -I. -I../../include -I../../BareMetal/osal
+ *             -Dmalloc=tlsf_malloc -Dfree=tlsf_free -Dcalloc=tlsf_calloc
+ *             -Drealloc=tlsf_realloc -o heap_bench heap_bench.c
+ *             ../../ls2k300/misc/memory_man.c ../../ls2k300/misc/fls.c
+ * usage:  heap_bench [-n ops] [-m heap_kb] [-s seed]
+ *
+ * bsp.h of this directory is found before include/bsp.h, so the heap of
+ * memory_man.c is built; malloc/free in this file are the renamed ones of
+ * memory_man.c, not of the host libc.
+ *
+ * Output: min, percentiles and max of malloc and free in ns, failed malloc,
+ * fragmentation at the end.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+
+#include "memory_man.h"
+#include "stable_counter.h"
+
+#define BENCH_SLOTS             4096
+#define BENCH_OPS_MAX           4000000
+#define BENCH_HEAP_KB_MAX       65536
+
+static unsigned char m_heap[BENCH_HEAP_KB_MAX * 1024];
+
+static void    *m_ptr[BENCH_SLOTS];
+static uint32_t m_alloc_ns[BENCH_OPS_MAX];
+static uint32_t m_free_ns[BENCH_OPS_MAX];
+
+//-----------------------------------------------------------------------------
+// memory_man.c needs these of libbsp and osal
+//-----------------------------------------------------------------------------
+
+void printk(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+}
+
+unsigned long get_clock_ticks(void)
+{
+    return 0;
+}
+
+int osal_is_osrunning(void)
+{
+    return 0;
+}
+
+void *osal_mutex_create(const char *name, uint32_t opt)
+{
+    return NULL;
+}
+
+int (osal_mutex_obtain)(void *mutex, uint32_t timeout_ms)
+{
+    return 0;
+}
+
+int osal_mutex_release(void *mutex)
+{
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+static uint32_t m_seed = 1;
+
+static uint32_t bench_rand(void)
+{
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    return m_seed;
+}
+
+/*
+ * 70% 16~256, 25% 256~4K, 5% 4K~64K
+ */
+static size_t bench_size(void)
+{
+    uint32_t r = bench_rand() % 100;
+
+    if (r < 70)
+        return 16 + bench_rand() % 241;
+    if (r < 95)
+        return 256 + bench_rand() % 3841;
+
+    return 4096 + bench_rand() % 61441;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void report(const char *name, uint32_t *ns, uint32_t count)
+{
+    uint64_t sum = 0;
+    uint32_t i;
+
+    if (count == 0)
+    {
+        printf("%-6s %9u\n", name, 0);
+        return;
+    }
+
+    qsort(ns, count, sizeof(uint32_t), cmp_u32);
+
+    for (i = 0; i < count; i++)
+    {
+        sum += ns[i];
+    }
+
+    printf("%-6s %9u %7u %7u %7u %7u %7u %7u %9u\n", name, count,
+           (unsigned)(sum / count), ns[0], ns[count / 2], ns[(uint64_t)count * 90 / 100],
+           ns[(uint64_t)count * 99 / 100], ns[(uint64_t)count * 999 / 1000], ns[count - 1]);
+}
+
+int main(int argc, char *argv[])
+{
+    heap_stats_t st;
+    uint32_t ops = 1000000, heap_kb = 8192, seed;
+    uint32_t allocs = 0, frees = 0, fails = 0, i, k;
+    uint64_t begin;
+    int n;
+
+    for (n = 1; n < argc; n++)
+    {
+        if (!strcmp(argv[n], "-n") && (n + 1 < argc))
+            ops = (uint32_t)strtoul(argv[++n], NULL, 0);
+        else if (!strcmp(argv[n], "-m") && (n + 1 < argc))
+            heap_kb = (uint32_t)strtoul(argv[++n], NULL, 0);
+        else if (!strcmp(argv[n], "-s") && (n + 1 < argc))
+            m_seed = (uint32_t)strtoul(argv[++n], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [-n ops] [-m heap_kb] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if ((ops == 0) || (ops > BENCH_OPS_MAX) || (heap_kb < 64) ||
+        (heap_kb > BENCH_HEAP_KB_MAX) || (m_seed == 0))
+    {
+        fprintf(stderr, "ops 1~%u, heap_kb 64~%u, seed not 0\n",
+                BENCH_OPS_MAX, BENCH_HEAP_KB_MAX);
+        return 1;
+    }
+
+    seed = m_seed;
+
+    if (heap_add_region(m_heap, (size_t)heap_kb * 1024) != 0)
+    {
+        fprintf(stderr, "add heap region fail\n");
+        return 1;
+    }
+
+    for (i = 0; i < ops; i++)
+    {
+        k = bench_rand() % BENCH_SLOTS;
+
+        if (m_ptr[k])
+        {
+            begin = stable_counter_read();
+            free(m_ptr[k]);
+            m_free_ns[frees++] = (uint32_t)stable_counter_to_ns(stable_counter_read() - begin);
+            m_ptr[k] = NULL;
+        }
+        else
+        {
+            size_t size = bench_size();
+
+            begin = stable_counter_read();
+            m_ptr[k] = malloc(size);
+            m_alloc_ns[allocs++] = (uint32_t)stable_counter_to_ns(stable_counter_read() - begin);
+
+            if (!m_ptr[k])
+                fails++;
+            else
+                memset(m_ptr[k], (int)k, size);
+        }
+    }
+
+    heap_stats(&st);
+
+    printf("ops %u, heap %u KB, seed %u\n", ops, heap_kb, seed);
+    printf("%-6s %9s %7s %7s %7s %7s %7s %7s %9s  (ns)\n",
+           "", "count", "avg", "min", "p50", "p90", "p99", "p99.9", "max");
+    report("malloc", m_alloc_ns, allocs);
+    report("free", m_free_ns, frees);
+    printf("malloc fail %u, free blocks %u, fragmentation %u.%u%%\n", fails,
+           st.free_block_count, st.fragmentation / 10, st.fragmentation % 10);
+
+    for (k = 0; k < BENCH_SLOTS; k++)
+    {
+        free(m_ptr[k]);
+    }
+
+    if (heap_verify_faulty_blocks() != 0)
+    {
+        fprintf(stderr, "heap corrupt\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,533 @@
+/*
+ * heap_trace.c
+ *
+ * created: 2026-10-16
+ *  author:
+ */
+
+/******************************************************************************
+ * Host tool, decode the heap trace dump of memory_man.c
+ *
+ * build:  gcc -O2 -o heap_trace heap_trace.c
+ * usage:  heap_trace [-i interval_us] [-t top] dump_file
+ *
+ * dump_file is the binary dump (heap_trace_dump() to a file), or the console
+ * log of shell command "heap trace dump", the lines begin with "HT:" are
+ * hex of the dump, other lines are ignored.
+ *
+ * Output:
+ *   timeline: time, live bytes, live blocks, span of live blocks, and the
+ *             fragmentation = hole bytes between live blocks / span
+ *   live set: blocks not freed at the end, grouped by caller and task
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+
+/*
+ * same as include/memory_man.h
+ */
+#define HEAP_TRACE_MAGIC        0x43525448
+#define HEAP_TRACE_VERSION      1
+
+#define HEAP_TRACE_MALLOC       1
+#define HEAP_TRACE_FREE         2
+#define HEAP_TRACE_RESIZE       3
+
+typedef struct heap_trace_rec
+{
+    uint64_t timestamp;
+    uint64_t ptr;
+    uint64_t caller;
+    uint32_t size;
+    uint16_t task_id;
+    uint8_t  op;
+    uint8_t  cls;
+} heap_trace_rec_t;
+
+typedef struct heap_trace_hdr
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t rec_size;
+    uint32_t count;
+    uint32_t lost;
+    uint64_t counter_hz;
+} heap_trace_hdr_t;
+
+typedef struct live_blk
+{
+    uint64_t ptr;
+    uint64_t caller;
+    uint32_t size;
+    uint16_t task_id;
+    uint8_t  cls;
+    uint8_t  used;
+} live_blk_t;
+
+typedef struct caller_sum
+{
+    uint64_t caller;
+    uint16_t task_id;
+    uint64_t bytes;
+    uint32_t blocks;
+} caller_sum_t;
+
+//-----------------------------------------------------------------------------
+// live set, open addressing hash by ptr
+//-----------------------------------------------------------------------------
+
+static live_blk_t *live_tab = NULL;
+static size_t      live_cap = 0;
+static size_t      live_cnt = 0;
+static size_t      live_slots = 0;              /* live and removed */
+static uint64_t    live_bytes = 0;
+
+static size_t live_hash(uint64_t ptr)
+{
+    return (size_t)((ptr >> 3) * 0x9E3779B97F4A7C15ULL) & (live_cap - 1);
+}
+
+static live_blk_t *live_find(uint64_t ptr)
+{
+    size_t i = live_hash(ptr);
+
+    while (live_tab[i].used)
+    {
+        if ((live_tab[i].used == 1) && (live_tab[i].ptr == ptr))
+            return &live_tab[i];
+        i = (i + 1) & (live_cap - 1);
+    }
+
+    return NULL;
+}
+
+static void live_insert(const heap_trace_rec_t *rec);
+
+static void live_grow(void)
+{
+    live_blk_t *old = live_tab;
+    size_t i, old_cap = live_cap;
+
+    /*
+     * rehash at same size if most slots are removed ones
+     */
+    if (!live_cap)
+        live_cap = 1024;
+    else if (live_cnt * 4 > live_cap)
+        live_cap *= 2;
+    live_tab = (live_blk_t *)calloc(live_cap, sizeof(live_blk_t));
+    if (!live_tab)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    live_cnt = 0;
+    live_slots = 0;
+    live_bytes = 0;
+
+    for (i = 0; i < old_cap; i++)
+    {
+        if (old[i].used == 1)
+        {
+            heap_trace_rec_t rec;
+
+            rec.ptr     = old[i].ptr;
+            rec.caller  = old[i].caller;
+            rec.size    = old[i].size;
+            rec.task_id = old[i].task_id;
+            rec.cls     = old[i].cls;
+            live_insert(&rec);
+        }
+    }
+
+    free(old);
+}
+
+static void live_insert(const heap_trace_rec_t *rec)
+{
+    size_t i;
+
+    if ((live_slots + 1) * 2 > live_cap)
+    {
+        live_grow();
+    }
+
+    i = live_hash(rec->ptr);
+    while (live_tab[i].used == 1)
+    {
+        i = (i + 1) & (live_cap - 1);
+    }
+
+    if (live_tab[i].used == 0)
+        live_slots++;
+
+    live_tab[i].ptr     = rec->ptr;
+    live_tab[i].caller  = rec->caller;
+    live_tab[i].size    = rec->size;
+    live_tab[i].task_id = rec->task_id;
+    live_tab[i].cls     = rec->cls;
+    live_tab[i].used    = 1;
+
+    live_cnt++;
+    live_bytes += rec->size;
+}
+
+static void live_remove(live_blk_t *blk)
+{
+    live_bytes -= blk->size;
+    live_cnt--;
+    blk->used = 2;                          /* tombstone */
+}
+
+//-----------------------------------------------------------------------------
+// fragmentation of the live set
+//-----------------------------------------------------------------------------
+
+static int cmp_ptr(const void *a, const void *b)
+{
+    const live_blk_t *x = *(const live_blk_t * const *)a;
+    const live_blk_t *y = *(const live_blk_t * const *)b;
+
+    return x->ptr < y->ptr ? -1 : x->ptr > y->ptr;
+}
+
+/*
+ * span: from the first to the end of the last live block, sum of classes
+ * fragmentation: holes between live blocks / span, in 1/1000
+ */
+static void live_span(uint64_t *span_out, unsigned *frag_out)
+{
+    live_blk_t **v;
+    uint64_t span = 0, holes = 0;
+    size_t i, n = 0;
+
+    v = (live_blk_t **)malloc((live_cnt + 1) * sizeof(live_blk_t *));
+    if (!v)
+    {
+        exit(1);
+    }
+
+    for (i = 0; i < live_cap; i++)
+    {
+        if (live_tab[i].used == 1)
+            v[n++] = &live_tab[i];
+    }
+
+    qsort(v, n, sizeof(live_blk_t *), cmp_ptr);
+
+    for (i = 0; i < n; i++)
+    {
+        uint64_t end;
+
+        /*
+         * first block of a class
+         */
+        if ((i == 0) || (v[i]->cls != v[i-1]->cls))
+        {
+            span += v[i]->size;
+            continue;
+        }
+
+        end = v[i-1]->ptr + v[i-1]->size;
+
+        span += v[i]->ptr + v[i]->size - end;
+        if (v[i]->ptr > end)
+            holes += v[i]->ptr - end;
+    }
+
+    free(v);
+
+    *span_out = span;
+    *frag_out = span ? (unsigned)(holes * 1000 / span) : 0;
+}
+
+//-----------------------------------------------------------------------------
+// input
+//-----------------------------------------------------------------------------
+
+static unsigned char *read_all(const char *path, size_t *len)
+{
+    FILE *fp = fopen(path, "rb");
+    unsigned char *buf;
+    long n;
+
+    if (!fp)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    n = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    buf = (unsigned char *)malloc(n + 1);
+    if (!buf || (fread(buf, 1, n, fp) != (size_t)n))
+    {
+        fclose(fp);
+        free(buf);
+        return NULL;
+    }
+
+    fclose(fp);
+    buf[n] = 0;
+    *len = (size_t)n;
+
+    return buf;
+}
+
+static int hex_val(int c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/*
+ * console log → binary, in place
+ */
+static size_t decode_log(unsigned char *buf, size_t len)
+{
+    size_t in = 0, out = 0;
+
+    while (in < len)
+    {
+        size_t eol = in;
+
+        while ((eol < len) && (buf[eol] != '\n'))
+            eol++;
+
+        if ((eol - in > 3) && !memcmp(buf + in, "HT:", 3))
+        {
+            size_t i = in + 3;
+
+            while (i + 1 < eol)
+            {
+                int hi, lo;
+
+                if (isspace(buf[i]))
+                {
+                    i++;
+                    continue;
+                }
+
+                hi = hex_val(buf[i]);
+                lo = hex_val(buf[i+1]);
+                if ((hi < 0) || (lo < 0))
+                    break;
+
+                buf[out++] = (unsigned char)(hi << 4 | lo);
+                i += 2;
+            }
+        }
+
+        in = eol + 1;
+    }
+
+    return out;
+}
+
+//-----------------------------------------------------------------------------
+
+static int cmp_sum(const void *a, const void *b)
+{
+    const caller_sum_t *x = (const caller_sum_t *)a;
+    const caller_sum_t *y = (const caller_sum_t *)b;
+
+    return x->bytes < y->bytes ? 1 : x->bytes > y->bytes ? -1 : 0;
+}
+
+static void show_live_set(int top)
+{
+    caller_sum_t *sum;
+    size_t i, j, n = 0;
+
+    sum = (caller_sum_t *)calloc(live_cnt + 1, sizeof(caller_sum_t));
+    if (!sum)
+    {
+        exit(1);
+    }
+
+    for (i = 0; i < live_cap; i++)
+    {
+        live_blk_t *blk = &live_tab[i];
+
+        if (blk->used != 1)
+            continue;
+
+        for (j = 0; j < n; j++)
+        {
+            if ((sum[j].caller == blk->caller) && (sum[j].task_id == blk->task_id))
+                break;
+        }
+
+        if (j == n)
+        {
+            sum[n].caller  = blk->caller;
+            sum[n].task_id = blk->task_id;
+            n++;
+        }
+
+        sum[j].bytes += blk->size;
+        sum[j].blocks++;
+    }
+
+    qsort(sum, n, sizeof(caller_sum_t), cmp_sum);
+
+    printf("\nlive set at end: %llu bytes, %zu blocks\n",
+           (unsigned long long)live_bytes, live_cnt);
+    printf("  %-18s %6s %12s %8s\n", "caller", "task", "bytes", "blocks");
+
+    for (i = 0; (i < n) && ((int)i < top); i++)
+    {
+        printf("  0x%016llx %6u %12llu %8u\n", (unsigned long long)sum[i].caller,
+               sum[i].task_id, (unsigned long long)sum[i].bytes, sum[i].blocks);
+    }
+
+    free(sum);
+}
+
+int main(int argc, char *argv[])
+{
+    heap_trace_hdr_t hdr;
+    const heap_trace_rec_t *rec;
+    unsigned char *buf;
+    const char *path = NULL;
+    uint64_t interval_us = 100000, next_us = 0, t0 = 0, span;
+    size_t len, i;
+    unsigned frag, unknown = 0;
+    int top = 20;
+
+    for (i = 1; i < (size_t)argc; i++)
+    {
+        if (!strcmp(argv[i], "-i") && (i + 1 < (size_t)argc))
+            interval_us = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-t") && (i + 1 < (size_t)argc))
+            top = atoi(argv[++i]);
+        else
+            path = argv[i];
+    }
+
+    if (!path)
+    {
+        fprintf(stderr, "usage: %s [-i interval_us] [-t top] dump_file\n", argv[0]);
+        return 1;
+    }
+
+    buf = read_all(path, &len);
+    if (!buf)
+    {
+        return 1;
+    }
+
+    if ((len < sizeof(hdr)) || (*(uint32_t *)buf != HEAP_TRACE_MAGIC))
+    {
+        len = decode_log(buf, len);
+    }
+
+    if (len < sizeof(hdr))
+    {
+        fprintf(stderr, "no trace data\n");
+        return 1;
+    }
+
+    memcpy(&hdr, buf, sizeof(hdr));
+
+    if ((hdr.magic != HEAP_TRACE_MAGIC) || (hdr.version != HEAP_TRACE_VERSION) ||
+        (hdr.rec_size != sizeof(heap_trace_rec_t)) || (hdr.counter_hz == 0))
+    {
+        fprintf(stderr, "bad trace header\n");
+        return 1;
+    }
+
+    if (len < sizeof(hdr) + (size_t)hdr.count * sizeof(heap_trace_rec_t))
+    {
+        fprintf(stderr, "trace truncated, %u records expected\n", hdr.count);
+        hdr.count = (uint32_t)((len - sizeof(hdr)) / sizeof(heap_trace_rec_t));
+    }
+
+    printf("%u records, %u lost before, counter %llu Hz\n", hdr.count, hdr.lost,
+           (unsigned long long)hdr.counter_hz);
+    if (hdr.lost)
+    {
+        printf("note: blocks allocated before the first record are unknown\n");
+    }
+
+    live_grow();
+
+    printf("\n%12s %12s %8s %12s %6s\n", "time(us)", "live bytes", "blocks", "span", "frag%");
+
+    rec = (const heap_trace_rec_t *)(buf + sizeof(hdr));
+
+    for (i = 0; i < hdr.count; i++, rec++)
+    {
+        uint64_t t;
+        live_blk_t *blk;
+
+        if (i == 0)
+            t0 = rec->timestamp;
+
+        t = (rec->timestamp - t0) * 1000000ULL / hdr.counter_hz;
+
+        switch (rec->op)
+        {
+            case HEAP_TRACE_MALLOC:
+                live_insert(rec);
+                break;
+
+            case HEAP_TRACE_FREE:
+                blk = live_find(rec->ptr);
+                if (blk)
+                    live_remove(blk);
+                else
+                    unknown++;
+                break;
+
+            case HEAP_TRACE_RESIZE:
+                blk = live_find(rec->ptr);
+                if (blk)
+                {
+                    live_bytes += (uint64_t)rec->size - blk->size;
+                    blk->size = rec->size;
+                }
+                else
+                    unknown++;
+                break;
+
+            default:
+                unknown++;
+                break;
+        }
+
+        if ((t >= next_us) || (i + 1 == hdr.count))
+        {
+            live_span(&span, &frag);
+            printf("%12llu %12llu %8zu %12llu %3u.%u\n", (unsigned long long)t,
+                   (unsigned long long)live_bytes, live_cnt, (unsigned long long)span,
+                   frag / 10, frag % 10);
+            next_us = t + interval_us;
+        }
+    }
+
+    if (unknown)
+    {
+        printf("%u records refer to blocks not in the trace\n", unknown);
+    }
+
+    show_live_set(top);
+
+    free(live_tab);
+    free(buf);
+
+    return 0;
+}
+
+/*
+ * @@ END
+ */